@@ -22,6 +22,7 @@
 #include <bitcoin/bitcoin/handlers.hpp>
 #include <bitcoin/bitcoin/version.hpp>
 #include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/block_view.hpp>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/chain/compact.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
@@ -37,6 +38,7 @@
 #include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/chain/stealth_record.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/chain/transaction_view.hpp>
 #include <bitcoin/bitcoin/chain/witness.hpp>
 #include <bitcoin/bitcoin/config/authority.hpp>
 #include <bitcoin/bitcoin/config/base16.hpp>
@@ -76,15 +78,19 @@
 #include <bitcoin/bitcoin/log/features/metric.hpp>
 #include <bitcoin/bitcoin/log/features/rate.hpp>
 #include <bitcoin/bitcoin/log/features/timer.hpp>
+#include <bitcoin/bitcoin/machine/decoded_script.hpp>
 #include <bitcoin/bitcoin/machine/interpreter.hpp>
 #include <bitcoin/bitcoin/machine/number.hpp>
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/machine/program.hpp>
 #include <bitcoin/bitcoin/machine/rule_fork.hpp>
+#include <bitcoin/bitcoin/machine/script_cache.hpp>
 #include <bitcoin/bitcoin/machine/script_pattern.hpp>
 #include <bitcoin/bitcoin/machine/script_version.hpp>
 #include <bitcoin/bitcoin/machine/sighash_algorithm.hpp>
+#include <bitcoin/bitcoin/machine/signature_cache.hpp>
+#include <bitcoin/bitcoin/machine/signature_queue.hpp>
 #include <bitcoin/bitcoin/math/checksum.hpp>
 #include <bitcoin/bitcoin/math/crypto.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
@@ -141,6 +147,7 @@
 #include <bitcoin/bitcoin/utility/binary.hpp>
 #include <bitcoin/bitcoin/utility/collection.hpp>
 #include <bitcoin/bitcoin/utility/color.hpp>
+#include <bitcoin/bitcoin/utility/compute_once.hpp>
 #include <bitcoin/bitcoin/utility/conditional_lock.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
@@ -159,6 +166,7 @@
 #include <bitcoin/bitcoin/utility/monitor.hpp>
 #include <bitcoin/bitcoin/utility/noncopyable.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
 #include <bitcoin/bitcoin/utility/pending.hpp>
 #include <bitcoin/bitcoin/utility/png.hpp>
 #include <bitcoin/bitcoin/utility/prioritized_mutex.hpp>
@@ -169,6 +177,8 @@
 #include <bitcoin/bitcoin/utility/sequencer.hpp>
 #include <bitcoin/bitcoin/utility/sequential_lock.hpp>
 #include <bitcoin/bitcoin/utility/serializer.hpp>
+#include <bitcoin/bitcoin/utility/sha256_writer.hpp>
+#include <bitcoin/bitcoin/utility/sliding_window.hpp>
 #include <bitcoin/bitcoin/utility/socket.hpp>
 #include <bitcoin/bitcoin/utility/string.hpp>
 #include <bitcoin/bitcoin/utility/subscriber.hpp>
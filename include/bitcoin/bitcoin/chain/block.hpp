@@ -25,17 +25,22 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <boost/optional.hpp>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/chain/header.hpp>
 #include <bitcoin/bitcoin/chain/transaction.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/machine/script_cache.hpp>
+#include <bitcoin/bitcoin/machine/signature_cache.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/asio.hpp>
+#include <bitcoin/bitcoin/utility/compute_once.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -101,6 +106,7 @@ public:
     bool from_data(const data_chunk& data, bool witness=false);
     bool from_data(std::istream& stream, bool witness=false);
     bool from_data(reader& source, bool witness=false);
+    bool from_data(byte_deserializer& source, bool witness=false);
 
     bool is_valid() const;
 
@@ -110,6 +116,7 @@ public:
     data_chunk to_data(bool witness=false) const;
     void to_data(std::ostream& stream, bool witness=false) const;
     void to_data(writer& sink, bool witness=false) const;
+    void to_data(byte_serializer& sink, bool witness=false) const;
     hash_list to_hashes(bool witness=false) const;
 
     // Properties (size, accessors, cache).
@@ -175,8 +182,25 @@ public:
         bool header=true) const;
     code accept_transactions(const chain_state& state) const;
     code connect() const;
-    code connect(const chain_state& state) const;
-    code connect_transactions(const chain_state& state) const;
+
+    /// Signature checks consult and populate cache when it is not null.
+    /// Scripts of txs in scripts are not run, and connected txs are added
+    /// to scripts, when it is not null.
+    code connect(const chain_state& state,
+        machine::signature_cache* cache=nullptr,
+        machine::script_cache* scripts=nullptr) const;
+    code connect_transactions(const chain_state& state,
+        machine::signature_cache* cache=nullptr,
+        machine::script_cache* scripts=nullptr) const;
+
+    /// Verify input scripts concurrently, result is identical to serial.
+    /// Single signature checks are deferred to a separate concurrent pass.
+    code connect(const chain_state& state, threadpool& pool,
+        machine::signature_cache* cache=nullptr,
+        machine::script_cache* scripts=nullptr) const;
+    code connect_transactions(const chain_state& state, threadpool& pool,
+        machine::signature_cache* cache=nullptr,
+        machine::script_cache* scripts=nullptr) const;
 
     // THIS IS FOR LIBRARY USE ONLY, DO NOT CREATE A DEPENDENCY ON IT.
     mutable validation validation;
@@ -185,21 +209,23 @@ protected:
     void reset();
 
 private:
-    typedef boost::optional<size_t> optional_size;
+    template <class Source>
+    bool deserialize(Source& source, bool witness);
 
-    optional_size total_inputs_cache() const;
-    optional_size non_coinbase_inputs_cache() const;
+    template <class Sink>
+    void serialize(Sink& sink, bool witness) const;
 
     chain::header header_;
     transaction::list transactions_;
 
-    // These share a mutext as they are not expected to contend.
-    mutable boost::optional<bool> segregated_;
-    mutable optional_size total_inputs_;
-    mutable optional_size non_coinbase_inputs_;
-    mutable boost::optional<size_t> base_size_;
-    mutable boost::optional<size_t> total_size_;
-    mutable upgrade_mutex mutex_;
+    // Published once per computation, readers do not lock.
+    mutable compute_once<size_t> total_inputs_;
+    mutable compute_once<size_t> non_coinbase_inputs_;
+    mutable compute_once<size_t> base_size_;
+    mutable compute_once<size_t> total_size_;
+
+    // Set by strip_witness, segregation is otherwise computed on demand.
+    bool stripped_;
 };
 
 } // namespace chain
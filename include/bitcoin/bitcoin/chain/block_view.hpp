@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_BLOCK_VIEW_HPP
+#define LIBBITCOIN_CHAIN_BLOCK_VIEW_HPP
+
+#include <cstddef>
+#include <memory>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction_view.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/// A read-only view of a wire block in a caller owned buffer (such as a
+/// message payload or memory mapped file), which must outlive the view, or
+/// in a buffer owned by the view. Each transaction is indexed by a
+/// transaction_view, nothing is copied.
+class BC_API block_view
+{
+public:
+    /// Parse the block at the front of the buffer, which may contain
+    /// trailing bytes (see serialized_size).
+    block_view(data_slice buffer);
+
+    /// Take ownership of the buffer, the block is held as this single
+    /// allocation plus its index. The buffer is shared by copies of the view
+    /// (and their transaction views) and is released with the last of them.
+    block_view(data_chunk&& buffer);
+
+    /// False if the buffer does not begin with a valid block.
+    bool is_valid() const;
+
+    /// The block bytes (including witnesses) within the buffer.
+    data_slice data() const;
+    size_t serialized_size() const;
+
+    /// The header bytes, hash and materialized header.
+    data_slice header_data() const;
+    hash_digest hash() const;
+    chain::header to_header() const;
+
+    const transaction_view::list& transactions() const;
+
+    /// Materialize an owned block from the view.
+    block to_block(bool witness=true) const;
+
+private:
+    bool parse();
+
+    // Null unless the view owns the buffer.
+    const std::shared_ptr<const data_chunk> buffer_;
+    const uint8_t* const begin_;
+    const uint8_t* end_;
+    bool valid_;
+    transaction_view::list transactions_;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
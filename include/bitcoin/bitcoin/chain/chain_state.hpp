@@ -19,16 +19,17 @@
 #ifndef LIBBITCOIN_CHAIN_CHAIN_STATE_HPP
 #define LIBBITCOIN_CHAIN_CHAIN_STATE_HPP
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
-#include <deque>
 #include <bitcoin/bitcoin/config/checkpoint.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/rule_fork.hpp>
+#include <bitcoin/bitcoin/utility/sliding_window.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -39,9 +40,9 @@ class header;
 class BC_API chain_state
 {
 public:
-    typedef std::deque<uint32_t> bitss;
-    typedef std::deque<uint32_t> versions;
-    typedef std::deque<uint32_t> timestamps;
+    typedef sliding_window<uint32_t> bitss;
+    typedef sliding_window<uint32_t> versions;
+    typedef sliding_window<uint32_t> timestamps;
     typedef struct { size_t count; size_t high; } range;
 
     typedef std::shared_ptr<chain_state> ptr;
@@ -169,6 +170,12 @@ public:
     bool is_under_checkpoint() const;
 
 protected:
+    // So that header may advance a state in place for batch validation.
+    friend class header;
+
+    /// Advance this state to that of the header at the next height.
+    void advance(const chain::header& header);
+
     struct activations
     {
         // The forks that are active at this height.
@@ -194,9 +201,27 @@ private:
     static size_t bip9_bit0_height(size_t height, uint32_t forks);
     static size_t bip9_bit1_height(size_t height, uint32_t forks);
 
-    static data to_pool(const chain_state& top);
-    static data to_block(const chain_state& pool, const block& block);
-    static data to_header(const chain_state& parent, const header& header);
+    // Running summary of the ordered values, maintained on promotion.
+    struct tally
+    {
+        // Counts of ordered versions at or above each bip34-based version.
+        size_t bip34_versions;
+        size_t bip66_versions;
+        size_t bip65_versions;
+
+        // The highest ordered timestamps (median window) sorted by value.
+        size_t timestamps;
+        std::array<uint32_t, median_time_past_interval> sorted;
+    };
+
+    static tally to_tally(const data& values);
+    static activations activation(const data& values, const tally& counts,
+        uint32_t forks);
+    static uint32_t median_time_past(const tally& counts);
+
+    static void promote(data& values, tally& counts, uint32_t forks);
+    static void populate(data& values, const header& header, uint32_t forks);
+    void compute();
 
     static uint32_t work_required_retarget(const data& values);
     static uint32_t retarget_timespan(const chain_state::data& values);
@@ -210,7 +235,7 @@ private:
 
     // This is retained as an optimization for other constructions.
     // A similar height clone can be partially computed, reducing query cost.
-    const data data_;
+    data data_;
 
     // Configured forks are saved for state transitions.
     const uint32_t forks_;
@@ -218,10 +243,13 @@ private:
     // Checkpoints do not affect the data that is collected or promoted.
     const config::checkpoint::list& checkpoints_;
 
-    // These are computed on construct from sample and checkpoints.
-    const activations active_;
-    const uint32_t median_time_past_;
-    const uint32_t work_required_;
+    // This is promoted along with data, avoiding rescans of its collections.
+    tally tally_;
+
+    // These are computed on construct (or advance) from sample and checkpoints.
+    activations active_;
+    uint32_t median_time_past_;
+    uint32_t work_required_;
 };
 
 } // namespace chain
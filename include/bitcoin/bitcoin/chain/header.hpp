@@ -29,9 +29,13 @@
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/error.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/compute_once.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -91,6 +95,7 @@ public:
     bool from_data(const data_chunk& data, bool wire=true);
     bool from_data(std::istream& stream, bool wire=true);
     bool from_data(reader& source, bool wire=true);
+    bool from_data(byte_deserializer& source, bool wire=true);
     bool from_data(reader& source, hash_digest&& hash, bool wire=true);
     bool from_data(reader& source, const hash_digest& hash, bool wire=true);
 
@@ -102,6 +107,7 @@ public:
     data_chunk to_data(bool wire=true) const;
     void to_data(std::ostream& stream, bool wire=true) const;
     void to_data(writer& sink, bool wire=true) const;
+    void to_data(byte_serializer& sink, bool wire=true) const;
 
     // Properties (size, accessors, cache).
     //-------------------------------------------------------------------------
@@ -142,6 +148,15 @@ public:
     code accept() const;
     code accept(const chain_state& state) const;
 
+    /// Validate a contiguous list of headers that descends from the parent.
+    /// Context free checks (including hashing) are performed concurrently and
+    /// contextual checks in a single ordered pass over one advancing state.
+    /// Results are set for each header, with orphan_block following failure.
+    /// Returns the state of the last valid header or nullptr if none valid.
+    static chain_state::ptr validate(const list& headers,
+        const chain_state& parent, threadpool& pool,
+        std::vector<code>& results);
+
     // THIS IS FOR LIBRARY USE ONLY, DO NOT CREATE A DEPENDENCY ON IT.
     mutable validation validation;
 
@@ -153,12 +168,13 @@ protected:
     void invalidate_cache() const;
 
 private:
-    typedef std::shared_ptr<hash_digest> hash_ptr;
+    template <class Source>
+    bool deserialize(Source& source, bool wire);
 
-    hash_ptr hash_cache() const;
+    template <class Sink>
+    void serialize(Sink& sink, bool wire) const;
 
-    mutable hash_ptr hash_;
-    mutable upgrade_mutex mutex_;
+    mutable compute_once<hash_digest> hash_;
 
     uint32_t version_;
     hash_digest previous_block_hash_;
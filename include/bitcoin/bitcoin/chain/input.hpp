@@ -29,7 +29,10 @@
 #include <bitcoin/bitcoin/chain/witness.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/compute_once.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 #include <bitcoin/bitcoin/wallet/payment_address.hpp>
@@ -79,6 +82,7 @@ public:
     bool from_data(const data_chunk& data, bool wire=true, bool witness=false);
     bool from_data(std::istream& stream, bool wire=true, bool witness=false);
     bool from_data(reader& source, bool wire=true, bool witness=false);
+    bool from_data(byte_deserializer& source, bool wire=true, bool witness=false);
 
     bool is_valid() const;
 
@@ -88,6 +92,7 @@ public:
     data_chunk to_data(bool wire=true, bool witness=false) const;
     void to_data(std::ostream& stream, bool wire=true, bool witness=false) const;
     void to_data(writer& sink, bool wire=true, bool witness=false) const;
+    void to_data(byte_serializer& sink, bool wire=true, bool witness=false) const;
 
     // Properties (size, accessors, cache).
     //-------------------------------------------------------------------------
@@ -143,12 +148,13 @@ protected:
     void invalidate_cache() const;
 
 private:
-    typedef std::shared_ptr<wallet::payment_address::list> addresses_ptr;
+    template <class Source>
+    bool deserialize(Source& source, bool wire, bool witness);
 
-    addresses_ptr addresses_cache() const;
+    template <class Sink>
+    void serialize(Sink& sink, bool wire, bool witness) const;
 
-    mutable upgrade_mutex mutex_;
-    mutable addresses_ptr addresses_;
+    mutable compute_once<wallet::payment_address::list> addresses_;
 
     output_point previous_output_;
     chain::script script_;
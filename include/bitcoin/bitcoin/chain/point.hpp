@@ -28,7 +28,9 @@
 #include <bitcoin/bitcoin/chain/point_iterator.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
 namespace libbitcoin {
@@ -76,6 +78,7 @@ public:
     bool from_data(const data_chunk& data, bool wire=true);
     bool from_data(std::istream& stream, bool wire=true);
     bool from_data(reader& source, bool wire=true);
+    bool from_data(byte_deserializer& source, bool wire=true);
 
     bool is_valid() const;
 
@@ -85,6 +88,7 @@ public:
     data_chunk to_data(bool wire=true) const;
     void to_data(std::ostream& stream, bool wire=true) const;
     void to_data(writer& sink, bool wire=true) const;
+    void to_data(byte_serializer& sink, bool wire=true) const;
 
     // Iteration (limited to store serialization).
     //-------------------------------------------------------------------------
@@ -126,6 +130,12 @@ protected:
     void reset();
 
 private:
+    template <class Source>
+    bool deserialize(Source& source, bool wire);
+
+    template <class Sink>
+    void serialize(Sink& sink, bool wire) const;
+
     hash_digest hash_;
     uint32_t index_;
     bool valid_;
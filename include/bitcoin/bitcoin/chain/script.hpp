@@ -32,8 +32,13 @@
 #include <bitcoin/bitcoin/machine/rule_fork.hpp>
 #include <bitcoin/bitcoin/machine/script_pattern.hpp>
 #include <bitcoin/bitcoin/machine/script_version.hpp>
+#include <bitcoin/bitcoin/machine/signature_cache.hpp>
+#include <bitcoin/bitcoin/machine/signature_queue.hpp>
+#include <bitcoin/bitcoin/utility/compute_once.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
@@ -86,6 +91,7 @@ public:
     bool from_data(const data_chunk& encoded, bool prefix);
     bool from_data(std::istream& stream, bool prefix);
     bool from_data(reader& source, bool prefix);
+    bool from_data(byte_deserializer& source, bool prefix);
 
     /// Deserialization invalidates the iterator.
     void from_operations(operation::list&& ops);
@@ -104,6 +110,7 @@ public:
     data_chunk to_data(bool prefix) const;
     void to_data(std::ostream& stream, bool prefix) const;
     void to_data(writer& sink, bool prefix) const;
+    void to_data(byte_serializer& sink, bool prefix) const;
 
     std::string to_string(uint32_t active_forks) const;
 
@@ -133,11 +140,13 @@ public:
         script_version version=script_version::unversioned,
         uint64_t value=max_uint64);
 
+    /// Successful checks are cached when cache is not null, pass no cache
+    /// to fully verify the signature (consensus-critical revalidation).
     static bool check_signature(const ec_signature& signature,
         uint8_t sighash_type, const data_chunk& public_key,
         const script& script_code, const transaction& tx, uint32_t input_index,
         script_version version=script_version::unversioned,
-        uint64_t value=max_uint64);
+        uint64_t value=max_uint64, machine::signature_cache* cache=nullptr);
 
     static bool create_endorsement(endorsement& out, const ec_secret& secret,
         const script& prevout_script, const transaction& tx,
@@ -209,13 +218,19 @@ public:
     // Validation.
     //-------------------------------------------------------------------------
 
-    static code verify(const transaction& tx, uint32_t input, uint32_t forks);
+    /// Single signature checks are queued to deferred when it is not null.
+    /// A deferred result is valid only if all of the queued checks verify.
+    /// Signature checks consult and populate cache when it is not null.
+    static code verify(const transaction& tx, uint32_t input, uint32_t forks,
+        machine::signature_queue* deferred=nullptr,
+        machine::signature_cache* cache=nullptr);
 
     // TODO: move back to private.
     static code verify(const transaction& tx, uint32_t input_index,
         uint32_t forks, const script& input_script,
         const witness& input_witness, const script& prevout_script,
-        uint64_t value);
+        uint64_t value, machine::signature_queue* deferred=nullptr,
+        machine::signature_cache* cache=nullptr);
 
 protected:
     // So that input and output may call reset from their own.
@@ -227,6 +242,12 @@ protected:
     bool is_pay_to_script_hash(uint32_t forks) const;
 
 private:
+    template <class Source>
+    bool deserialize(Source& source, bool prefix);
+
+    template <class Sink>
+    void serialize(Sink& sink, bool prefix) const;
+
     static size_t serialized_size(const operation::list& ops);
     static data_chunk operations_to_data(const operation::list& ops);
     static hash_digest generate_unversioned_signature_hash(
@@ -238,13 +259,8 @@ private:
 
     void find_and_delete_(const data_chunk& endorsement);
 
-    operation::list& operations_move();
-    const operation::list& operations_copy() const;
-
-    // These are protected by mutex.
-    mutable operation::list operations_;
-    mutable bool cached_;
-    mutable upgrade_mutex mutex_;
+    // Parsed from bytes_ on first access, readers do not lock.
+    mutable compute_once<operation::list> operations_;
 
     data_chunk bytes_;
     bool valid_;
@@ -25,7 +25,6 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <boost/optional.hpp>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/chain/input.hpp>
 #include <bitcoin/bitcoin/chain/output.hpp>
@@ -36,7 +35,13 @@
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/rule_fork.hpp>
+#include <bitcoin/bitcoin/machine/script_cache.hpp>
+#include <bitcoin/bitcoin/machine/signature_cache.hpp>
+#include <bitcoin/bitcoin/machine/signature_queue.hpp>
+#include <bitcoin/bitcoin/utility/compute_once.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
@@ -107,6 +112,7 @@ public:
     bool from_data(const data_chunk& data, bool wire=true, bool witness=false);
     bool from_data(std::istream& stream, bool wire=true, bool witness=false);
     bool from_data(reader& source, bool wire=true, bool witness=false);
+    bool from_data(byte_deserializer& source, bool wire=true, bool witness=false);
 
     // Non-wire store deserializations to preserve hash.
     bool from_data(reader& source, hash_digest&& hash, bool wire=true, bool witness=false);
@@ -120,6 +126,7 @@ public:
     data_chunk to_data(bool wire=true, bool witness=false) const;
     void to_data(std::ostream& stream, bool wire=true, bool witness=false) const;
     void to_data(writer& sink, bool wire=true, bool witness=false) const;
+    void to_data(byte_serializer& sink, bool wire=true, bool witness=false) const;
 
     // Properties (size, accessors, cache).
     //-------------------------------------------------------------------------
@@ -188,8 +195,16 @@ public:
     code accept(bool transaction_pool=true) const;
     code accept(const chain_state& state, bool transaction_pool=true) const;
     code connect() const;
-    code connect(const chain_state& state) const;
-    code connect_input(const chain_state& state, size_t input_index) const;
+
+    /// Signature checks consult and populate cache when it is not null.
+    /// Scripts are not run if the tx is in scripts, which is populated
+    /// on success, when it is not null.
+    code connect(const chain_state& state,
+        machine::signature_cache* cache=nullptr,
+        machine::script_cache* scripts=nullptr) const;
+    code connect_input(const chain_state& state, size_t input_index,
+        machine::signature_queue* deferred=nullptr,
+        machine::signature_cache* cache=nullptr) const;
 
     // THIS IS FOR LIBRARY USE ONLY, DO NOT CREATE A DEPENDENCY ON IT.
     mutable validation validation;
@@ -200,31 +215,28 @@ protected:
     bool all_inputs_final() const;
 
 private:
-    typedef std::shared_ptr<hash_digest> hash_ptr;
-    typedef boost::optional<uint64_t> optional_value;
+    template <class Source>
+    bool deserialize(Source& source, bool wire, bool witness);
 
-    hash_ptr hash_cache() const;
-    optional_value total_input_value_cache() const;
-    optional_value total_output_value_cache() const;
+    template <class Sink>
+    void serialize(Sink& sink, bool wire, bool witness) const;
 
     uint32_t version_;
     uint32_t locktime_;
     input::list inputs_;
     output::list outputs_;
 
-    // These share a mutex as they are not expected to contend.
-    mutable hash_ptr hash_;
-    mutable hash_ptr witness_hash_;
-    mutable hash_ptr outputs_hash_;
-    mutable hash_ptr inpoints_hash_;
-    mutable hash_ptr sequences_hash_;
-    mutable upgrade_mutex hash_mutex_;
-
-    // These share a mutex as they are not expected to contend.
-    mutable optional_value total_input_value_;
-    mutable optional_value total_output_value_;
-    mutable boost::optional<bool> segregated_;
-    mutable upgrade_mutex mutex_;
+    // Published once per computation, readers do not lock.
+    mutable compute_once<hash_digest> hash_;
+    mutable compute_once<hash_digest> witness_hash_;
+    mutable compute_once<hash_digest> outputs_hash_;
+    mutable compute_once<hash_digest> inpoints_hash_;
+    mutable compute_once<hash_digest> sequences_hash_;
+    mutable compute_once<uint64_t> total_input_value_;
+    mutable compute_once<uint64_t> total_output_value_;
+
+    // Set by strip_witness, segregation is otherwise computed on demand.
+    bool stripped_;
 };
 
 } // namespace chain
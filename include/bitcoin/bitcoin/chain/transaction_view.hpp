@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_CHAIN_TRANSACTION_VIEW_HPP
+#define LIBBITCOIN_CHAIN_TRANSACTION_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/chain/output_point.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+/// A read-only view of a wire (satoshi protocol) transaction in a caller
+/// owned buffer, which must outlive the view. Construction records the
+/// offsets of each input, output and witness without copying any data.
+/// Owned objects are materialized only on demand. Unlike transaction, a
+/// view rejects non-minimal size encodings, so that its hashes of the
+/// buffer are identical to the hashes of the materialized transaction.
+class BC_API transaction_view
+{
+public:
+    typedef std::vector<transaction_view> list;
+
+    /// Parse the transaction at the front of the buffer, which may contain
+    /// trailing bytes (see serialized_size).
+    transaction_view(data_slice buffer);
+
+    /// False if the buffer does not begin with a valid transaction.
+    bool is_valid() const;
+
+    /// The transaction bytes (including witnesses) within the buffer.
+    data_slice data() const;
+    size_t serialized_size() const;
+
+    uint32_t version() const;
+    uint32_t locktime() const;
+    bool is_coinbase() const;
+    bool is_segregated() const;
+
+    /// Computed on each call, the view does not cache.
+    hash_digest hash(bool witness=false) const;
+
+    size_t inputs() const;
+    output_point previous_output(size_t index) const;
+    data_slice input_script(size_t index) const;
+    uint32_t sequence(size_t index) const;
+
+    /// The serialized witness stack (element count prefixed) of the input,
+    /// empty if the transaction has no witness section.
+    data_slice witness(size_t index) const;
+
+    size_t outputs() const;
+    uint64_t value(size_t index) const;
+    data_slice output_script(size_t index) const;
+
+    /// Materialize an owned transaction from the view.
+    transaction to_transaction(bool witness=true) const;
+
+private:
+    struct range
+    {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    struct input_record
+    {
+        uint32_t point;
+        range script;
+        range witness;
+    };
+
+    struct output_record
+    {
+        uint32_t value;
+        range script;
+    };
+
+    bool parse();
+    data_slice slice(const range& value) const;
+
+    const uint8_t* const begin_;
+    const uint8_t* end_;
+    bool valid_;
+    bool marker_;
+    bool segregated_;
+    uint32_t outputs_end_;
+    std::vector<input_record> inputs_;
+    std::vector<output_record> outputs_;
+};
+
+} // namespace chain
+} // namespace libbitcoin
+
+#endif
@@ -25,8 +25,12 @@
 #include <bitcoin/bitcoin/chain/script.hpp>
 #include <bitcoin/bitcoin/define.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
+#include <bitcoin/bitcoin/machine/signature_cache.hpp>
+#include <bitcoin/bitcoin/machine/signature_queue.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/deserializer.hpp>
 #include <bitcoin/bitcoin/utility/reader.hpp>
+#include <bitcoin/bitcoin/utility/serializer.hpp>
 #include <bitcoin/bitcoin/utility/thread.hpp>
 #include <bitcoin/bitcoin/utility/writer.hpp>
 
@@ -75,6 +79,7 @@ public:
     bool from_data(const data_chunk& encoded, bool prefix);
     bool from_data(std::istream& stream, bool prefix);
     bool from_data(reader& source, bool prefix);
+    bool from_data(byte_deserializer& source, bool prefix);
 
     /// The witness deserialized ccording to count and size prefixing.
     bool is_valid() const;
@@ -85,6 +90,7 @@ public:
     data_chunk to_data(bool prefix) const;
     void to_data(std::ostream& stream, bool prefix) const;
     void to_data(writer& sink, bool prefix) const;
+    void to_data(byte_serializer& sink, bool prefix) const;
 
     std::string to_string() const;
 
@@ -121,7 +127,9 @@ public:
     //-------------------------------------------------------------------------
 
     code verify(const transaction& tx, uint32_t input_index, uint32_t forks,
-        const script& program_script, uint64_t value) const;
+        const script& program_script, uint64_t value,
+        machine::signature_queue* deferred=nullptr,
+        machine::signature_cache* cache=nullptr) const;
 
 protected:
     // So that input may call reset from its own.
@@ -130,6 +138,12 @@ protected:
     void reset();
 
 private:
+    template <class Source>
+    bool deserialize(Source& source, bool prefix);
+
+    template <class Sink>
+    void serialize(Sink& sink, bool prefix) const;
+
     static size_t serialized_size(const data_stack& stack);
     static operation::list to_pay_key_hash(data_chunk&& program);
 
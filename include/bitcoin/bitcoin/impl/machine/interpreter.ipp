@@ -30,6 +30,7 @@
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/machine/program.hpp>
+#include <bitcoin/bitcoin/machine/signature_queue.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
@@ -97,7 +98,7 @@ inline interpreter::result interpreter::op_if(program& program)
             return error::op_if;
 
         value = program.stack_true(false);
-        program.pop();
+        program.drop();
     }
 
     program.open(value);
@@ -114,7 +115,7 @@ inline interpreter::result interpreter::op_notif(program& program)
             return error::op_notif;
 
         value = !program.stack_true(false);
-        program.pop();
+        program.drop();
     }
 
     program.open(value);
@@ -147,7 +148,7 @@ inline interpreter::result interpreter::op_verify(program& program)
     if (!program.stack_true(false))
         return error::op_verify2;
 
-    program.pop();
+    program.drop();
     return error::success;
 }
 
@@ -179,8 +180,8 @@ inline interpreter::result interpreter::op_drop2(program& program)
     if (program.size() < 2)
         return error::op_drop2;
 
-    program.pop();
-    program.pop();
+    program.drop();
+    program.drop();
     return error::success;
 }
 
@@ -189,11 +190,8 @@ inline interpreter::result interpreter::op_dup2(program& program)
     if (program.size() < 2)
         return error::op_dup2;
 
-    auto item1 = program.item(1);
-    auto item0 = program.item(0);
-
-    program.push_move(std::move(item1));
-    program.push_move(std::move(item0));
+    program.duplicate(1);
+    program.duplicate(1);
     return error::success;
 }
 
@@ -202,13 +200,9 @@ inline interpreter::result interpreter::op_dup3(program& program)
     if (program.size() < 3)
         return error::op_dup3;
 
-    auto item2 = program.item(2);
-    auto item1 = program.item(1);
-    auto item0 = program.item(0);
-
-    program.push_move(std::move(item2));
-    program.push_move(std::move(item1));
-    program.push_move(std::move(item0));
+    program.duplicate(2);
+    program.duplicate(2);
+    program.duplicate(2);
     return error::success;
 }
 
@@ -217,11 +211,8 @@ inline interpreter::result interpreter::op_over2(program& program)
     if (program.size() < 4)
         return error::op_over2;
 
-    auto item3 = program.item(3);
-    auto item2 = program.item(2);
-
-    program.push_move(std::move(item3));
-    program.push_move(std::move(item2));
+    program.duplicate(3);
+    program.duplicate(3);
     return error::success;
 }
 
@@ -233,12 +224,12 @@ inline interpreter::result interpreter::op_rot2(program& program)
     const auto position_5 = program.position(5);
     const auto position_4 = program.position(4);
 
-    auto copy_5 = *position_5;
-    auto copy_4 = *position_4;
+    auto item_5 = std::move(*position_5);
+    auto item_4 = std::move(*position_4);
 
     program.erase(position_5, position_4 + 1);
-    program.push_move(std::move(copy_5));
-    program.push_move(std::move(copy_4));
+    program.push_move(std::move(item_5));
+    program.push_move(std::move(item_4));
     return error::success;
 }
 
@@ -274,7 +265,7 @@ inline interpreter::result interpreter::op_drop(program& program)
     if (program.empty())
         return error::op_drop;
 
-    program.pop();
+    program.drop();
     return error::success;
 }
 
@@ -321,9 +312,9 @@ inline interpreter::result interpreter::op_roll(program& program)
     if (!program.pop_position(position))
         return error::op_roll;
 
-    auto copy = *position;
+    auto item = std::move(*position);
     program.erase(position);
-    program.push_move(std::move(copy));
+    program.push_move(std::move(item));
     return error::success;
 }
 
@@ -376,7 +367,10 @@ inline interpreter::result interpreter::op_equal(program& program)
     if (program.size() < 2)
         return error::op_equal;
 
-    program.push(program.pop() == program.pop());
+    const auto equal = program.item(0) == program.item(1);
+    program.drop();
+    program.drop();
+    program.push(equal);
     return error::success;
 }
 
@@ -385,8 +379,10 @@ inline interpreter::result interpreter::op_equal_verify(program& program)
     if (program.size() < 2)
         return error::op_equal_verify1;
 
-    return (program.pop() == program.pop()) ? error::success :
-        error::op_equal_verify2;
+    const auto equal = program.item(0) == program.item(1);
+    program.drop();
+    program.drop();
+    return equal ? error::success : error::op_equal_verify2;
 }
 
 inline interpreter::result interpreter::op_add1(program& program)
@@ -603,7 +599,9 @@ inline interpreter::result interpreter::op_ripemd160(program& program)
     if (program.empty())
         return error::op_ripemd160;
 
-    program.push_move(ripemd160_hash_chunk(program.pop()));
+    const auto hash = ripemd160_hash(program.item(0));
+    program.drop();
+    program.push_copy(hash);
     return error::success;
 }
 
@@ -612,7 +610,9 @@ inline interpreter::result interpreter::op_sha1(program& program)
     if (program.empty())
         return error::op_sha1;
 
-    program.push_move(sha1_hash_chunk(program.pop()));
+    const auto hash = sha1_hash(program.item(0));
+    program.drop();
+    program.push_copy(hash);
     return error::success;
 }
 
@@ -621,7 +621,9 @@ inline interpreter::result interpreter::op_sha256(program& program)
     if (program.empty())
         return error::op_sha256;
 
-    program.push_move(sha256_hash_chunk(program.pop()));
+    const auto hash = sha256_hash(program.item(0));
+    program.drop();
+    program.push_copy(hash);
     return error::success;
 }
 
@@ -630,7 +632,9 @@ inline interpreter::result interpreter::op_hash160(program& program)
     if (program.empty())
         return error::op_hash160;
 
-    program.push_move(ripemd160_hash_chunk(sha256_hash(program.pop())));
+    const auto hash = ripemd160_hash(sha256_hash(program.item(0)));
+    program.drop();
+    program.push_copy(hash);
     return error::success;
 }
 
@@ -639,7 +643,9 @@ inline interpreter::result interpreter::op_hash256(program& program)
     if (program.empty())
         return error::op_hash256;
 
-    program.push_move(sha256_hash_chunk(sha256_hash(program.pop())));
+    const auto hash = sha256_hash(sha256_hash(program.item(0)));
+    program.drop();
+    program.push_copy(hash);
     return error::success;
 }
 
@@ -661,7 +667,7 @@ inline interpreter::result interpreter::op_check_sig_verify(program& program)
     auto bip66 = chain::script::is_enabled(program.forks(), bip66_rule);
     auto bip143 = chain::script::is_enabled(program.forks(), bip143_rule);
 
-    const auto public_key = program.pop();
+    auto public_key = program.pop();
     auto endorsement = program.pop();
 
     // Create a subscript with endorsements stripped (sort of).
@@ -683,9 +689,25 @@ inline interpreter::result interpreter::op_check_sig_verify(program& program)
     // Version condition preserves independence of bip141 and bip143.
     auto version = bip143 ? program.version() : script_version::unversioned;
 
+    // Speculate success, the queue owner must verify or rerun the script.
+    if (program.deferred() != nullptr && !public_key.empty())
+    {
+        const auto cache = program.cache();
+        const auto hash = chain::script::generate_signature_hash(
+            program.transaction(), program.input_index(), script_code,
+                sighash, version, program.value());
+
+        // A cached check is known to succeed, so is not queued.
+        if (cache == nullptr || !cache->contains(hash, public_key, signature))
+            program.deferred()->enqueue(std::move(public_key), hash,
+                signature);
+
+        return error::success;
+    }
+
     return chain::script::check_signature(signature, sighash, public_key,
         script_code, program.transaction(), program.input_index(),
-            version, program.value()) ? error::success :
+            version, program.value(), program.cache()) ? error::success :
                 error::incorrect_signature;
 }
 
@@ -773,7 +795,7 @@ inline interpreter::result interpreter::op_check_multisig_verify(
             // Version condition preserves independence of bip141 and bip143.
             if (chain::script::check_signature(signature, sighash, *public_key,
                 script_code, program.transaction(), program.input_index(),
-                    version, program.value()))
+                    version, program.value(), program.cache()))
                 break;
 
             if (++public_key == public_keys.end())
@@ -68,6 +68,16 @@ inline const chain::transaction& program::transaction() const
     return transaction_;
 }
 
+inline signature_queue* program::deferred() const
+{
+    return deferred_;
+}
+
+inline signature_cache* program::cache() const
+{
+    return cache_;
+}
+
 // Program registers.
 //-----------------------------------------------------------------------------
 
@@ -152,7 +162,9 @@ inline bool program::set_jump_register(const operation& op, int32_t offset)
 // push
 inline void program::push(bool value)
 {
-    push_move(value ? value_type{ number::positive_1 } : value_type{});
+    static const value_type true_value{ number::positive_1 };
+    static const value_type false_value{};
+    push_copy(value ? true_value : false_value);
 }
 
 // Be explicit about the intent to move or copy, to get compiler help.
@@ -162,9 +174,20 @@ inline void program::push_move(value_type&& item)
 }
 
 // Be explicit about the intent to move or copy, to get compiler help.
-inline void program::push_copy(const value_type& item)
+// The item may reference the stack, so it is copied before the push.
+inline void program::push_copy(data_slice item)
 {
-    primary_.push_back(item);
+    if (dropped_.empty())
+    {
+        primary_.emplace_back(item.begin(), item.end());
+        return;
+    }
+
+    // Reuse a dropped buffer, which allocates only if it is too small.
+    auto buffer = std::move(dropped_.back());
+    dropped_.pop_back();
+    buffer.assign(item.begin(), item.end());
+    primary_.push_back(std::move(buffer));
 }
 
 // Primary stack (pop).
@@ -174,11 +197,20 @@ inline void program::push_copy(const value_type& item)
 inline data_chunk program::pop()
 {
     BITCOIN_ASSERT(!empty());
-    const auto value = primary_.back();
+    auto value = std::move(primary_.back());
     primary_.pop_back();
     return value;
 }
 
+// This must be guarded.
+// The buffer of the item is retained for reuse by push_copy.
+inline void program::drop()
+{
+    BITCOIN_ASSERT(!empty());
+    dropped_.push_back(std::move(primary_.back()));
+    primary_.pop_back();
+}
+
 inline bool program::pop(int32_t& out_value)
 {
     number value;
@@ -191,7 +223,12 @@ inline bool program::pop(int32_t& out_value)
 
 inline bool program::pop(number& out_number, size_t maxiumum_size)
 {
-    return !empty() && out_number.set_data(pop(), maxiumum_size);
+    if (empty())
+        return false;
+
+    const auto result = out_number.set_data(item(0), maxiumum_size);
+    drop();
+    return result;
 }
 
 inline bool program::pop_binary(number& first, number& second)
@@ -370,7 +407,7 @@ inline void program::push_alternate(value_type&& value)
 inline program::value_type program::pop_alternate()
 {
     BITCOIN_ASSERT(!alternate_.empty());
-    const auto value = alternate_.back();
+    auto value = std::move(alternate_.back());
     alternate_.pop_back();
     return value;
 }
@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_FLAT_HASH_SET_IPP
+#define LIBBITCOIN_FLAT_HASH_SET_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace libbitcoin {
+
+// The minimum table size is 2^3 slots.
+static constexpr size_t flat_hash_set_minimum_bits = 3;
+
+template <typename Key, typename Hasher>
+flat_hash_set<Key, Hasher>::flat_hash_set(size_t expected,
+    const Hasher& hasher)
+  : hasher_(hasher),
+    shift_(to_shift(expected)),
+    size_(0),
+    tags_(size_t(1) << (64u - shift_), 0),
+    keys_(tags_.size())
+{
+}
+
+// The table holds at least twice the expected number of keys.
+template <typename Key, typename Hasher>
+size_t flat_hash_set<Key, Hasher>::to_shift(size_t expected)
+{
+    auto bits = flat_hash_set_minimum_bits;
+
+    while ((size_t(1) << bits) < 2u * expected)
+        ++bits;
+
+    return 64u - bits;
+}
+
+template <typename Key, typename Hasher>
+bool flat_hash_set<Key, Hasher>::insert(const Key& key)
+{
+    if (2u * (size_ + 1u) > tags_.size())
+        grow();
+
+    // The low bit is set so that a zero tag identifies an empty slot.
+    const auto tag = hasher_(key) | 1u;
+    const auto slot = find(key, tag);
+
+    if (tags_[slot] != 0)
+        return false;
+
+    tags_[slot] = tag;
+    keys_[slot] = key;
+    ++size_;
+    return true;
+}
+
+template <typename Key, typename Hasher>
+bool flat_hash_set<Key, Hasher>::contains(const Key& key) const
+{
+    return tags_[find(key, hasher_(key) | 1u)] != 0;
+}
+
+template <typename Key, typename Hasher>
+void flat_hash_set<Key, Hasher>::clear()
+{
+    std::fill(tags_.begin(), tags_.end(), 0);
+    size_ = 0;
+}
+
+template <typename Key, typename Hasher>
+size_t flat_hash_set<Key, Hasher>::size() const
+{
+    return size_;
+}
+
+template <typename Key, typename Hasher>
+bool flat_hash_set<Key, Hasher>::empty() const
+{
+    return size_ == 0;
+}
+
+// Returns the slot of the key, or of the empty slot that terminates probing.
+template <typename Key, typename Hasher>
+size_t flat_hash_set<Key, Hasher>::find(const Key& key, uint64_t tag) const
+{
+    const auto mask = tags_.size() - 1u;
+
+    for (auto slot = static_cast<size_t>(tag >> shift_); ;
+        slot = (slot + 1u) & mask)
+    {
+        const auto current = tags_[slot];
+
+        if (current == 0 || (current == tag && keys_[slot] == key))
+            return slot;
+    }
+}
+
+// Tags are cached, so keys are relocated without being hashed again.
+template <typename Key, typename Hasher>
+void flat_hash_set<Key, Hasher>::grow()
+{
+    std::vector<uint64_t> tags(tags_.size() * 2u, 0);
+    std::vector<Key> keys(tags.size());
+    const auto mask = tags.size() - 1u;
+    --shift_;
+
+    for (size_t index = 0; index < tags_.size(); ++index)
+    {
+        const auto tag = tags_[index];
+
+        if (tag == 0)
+            continue;
+
+        auto slot = static_cast<size_t>(tag >> shift_);
+
+        while (tags[slot] != 0)
+            slot = (slot + 1u) & mask;
+
+        tags[slot] = tag;
+        keys[slot] = std::move(keys_[index]);
+    }
+
+    tags_.swap(tags);
+    keys_.swap(keys);
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SLIDING_WINDOW_IPP
+#define LIBBITCOIN_SLIDING_WINDOW_IPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+namespace libbitcoin {
+
+template <typename Type>
+sliding_window<Type>::sliding_window()
+  : start_(0)
+{
+}
+
+template <typename Type>
+sliding_window<Type>::sliding_window(std::initializer_list<Type> values)
+  : buffer_(values), start_(0)
+{
+}
+
+template <typename Type>
+sliding_window<Type>::sliding_window(const sliding_window& other)
+  : start_(0)
+{
+    buffer_.reserve(2 * other.size());
+    buffer_.assign(other.begin(), other.end());
+}
+
+template <typename Type>
+sliding_window<Type>::sliding_window(sliding_window&& other)
+  : buffer_(std::move(other.buffer_)), start_(other.start_)
+{
+    other.buffer_.clear();
+    other.start_ = 0;
+}
+
+template <typename Type>
+sliding_window<Type>& sliding_window<Type>::operator=(
+    const sliding_window& other)
+{
+    if (&other == this)
+        return *this;
+
+    buffer_.clear();
+    buffer_.reserve(2 * other.size());
+    buffer_.assign(other.begin(), other.end());
+    start_ = 0;
+    return *this;
+}
+
+template <typename Type>
+sliding_window<Type>& sliding_window<Type>::operator=(sliding_window&& other)
+{
+    buffer_ = std::move(other.buffer_);
+    start_ = other.start_;
+    other.buffer_.clear();
+    other.start_ = 0;
+    return *this;
+}
+
+template <typename Type>
+bool sliding_window<Type>::operator==(const sliding_window& other) const
+{
+    return size() == other.size() &&
+        std::equal(begin(), end(), other.begin());
+}
+
+template <typename Type>
+bool sliding_window<Type>::operator!=(const sliding_window& other) const
+{
+    return !(*this == other);
+}
+
+template <typename Type>
+typename sliding_window<Type>::iterator sliding_window<Type>::begin()
+{
+    return buffer_.data() + start_;
+}
+
+template <typename Type>
+typename sliding_window<Type>::iterator sliding_window<Type>::end()
+{
+    return buffer_.data() + buffer_.size();
+}
+
+template <typename Type>
+typename sliding_window<Type>::const_iterator
+sliding_window<Type>::begin() const
+{
+    return buffer_.data() + start_;
+}
+
+template <typename Type>
+typename sliding_window<Type>::const_iterator sliding_window<Type>::end() const
+{
+    return buffer_.data() + buffer_.size();
+}
+
+template <typename Type>
+typename sliding_window<Type>::reference sliding_window<Type>::front()
+{
+    return buffer_[start_];
+}
+
+template <typename Type>
+typename sliding_window<Type>::reference sliding_window<Type>::back()
+{
+    return buffer_.back();
+}
+
+template <typename Type>
+typename sliding_window<Type>::const_reference
+sliding_window<Type>::front() const
+{
+    return buffer_[start_];
+}
+
+template <typename Type>
+typename sliding_window<Type>::const_reference
+sliding_window<Type>::back() const
+{
+    return buffer_.back();
+}
+
+template <typename Type>
+typename sliding_window<Type>::reference sliding_window<Type>::operator[](
+    size_type index)
+{
+    return buffer_[start_ + index];
+}
+
+template <typename Type>
+typename sliding_window<Type>::const_reference
+sliding_window<Type>::operator[](size_type index) const
+{
+    return buffer_[start_ + index];
+}
+
+template <typename Type>
+typename sliding_window<Type>::size_type sliding_window<Type>::size() const
+{
+    return buffer_.size() - start_;
+}
+
+template <typename Type>
+bool sliding_window<Type>::empty() const
+{
+    return buffer_.size() == start_;
+}
+
+template <typename Type>
+void sliding_window<Type>::clear()
+{
+    buffer_.clear();
+    start_ = 0;
+}
+
+template <typename Type>
+void sliding_window<Type>::resize(size_type size)
+{
+    compact();
+    buffer_.resize(size);
+}
+
+template <typename Type>
+void sliding_window<Type>::push_back(Type value)
+{
+    // Reclaim the popped prefix only once it is at least as large as the
+    // window, so that the cost of moving the window is amortized over pops.
+    if (buffer_.size() == buffer_.capacity() && start_ >= size())
+        compact();
+
+    buffer_.push_back(std::move(value));
+}
+
+template <typename Type>
+void sliding_window<Type>::pop_front()
+{
+    if (++start_ == buffer_.size())
+        clear();
+}
+
+template <typename Type>
+void sliding_window<Type>::compact()
+{
+    if (start_ == 0)
+        return;
+
+    buffer_.erase(buffer_.begin(), buffer_.begin() + start_);
+    start_ = 0;
+}
+
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MACHINE_DECODED_SCRIPT_HPP
+#define LIBBITCOIN_MACHINE_DECODED_SCRIPT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/machine/opcode.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace machine {
+
+/// A flat decoding of script bytes, with one (code, offset, size) record per
+/// operation referencing push data within the bytes. Unlike operation::list
+/// this requires no allocation per operation, but it does not own the bytes,
+/// which must outlive the instance. Decoding stops at the first invalid
+/// operation, which is recorded as operation would (invalid code and data).
+class BC_API decoded_script
+{
+public:
+    struct record
+    {
+        opcode code;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    typedef std::vector<record> list;
+
+    decoded_script(data_slice bytes);
+
+    /// False if the last operation is invalid (script is not parseable).
+    bool is_valid() const;
+
+    bool empty() const;
+    size_t size() const;
+    const list& records() const;
+    opcode code(size_t index) const;
+    data_slice data(size_t index) const;
+
+    /// Consensus computations (as chain::script).
+    size_t sigops(bool accurate) const;
+    bool is_pay_script_hash_pattern() const;
+    bool is_witness_program_pattern() const;
+
+private:
+    const data_slice bytes_;
+    bool valid_;
+    list records_;
+};
+
+} // namespace machine
+} // namespace libbitcoin
+
+#endif
@@ -28,6 +28,8 @@
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/machine/script_version.hpp>
+#include <bitcoin/bitcoin/machine/signature_cache.hpp>
+#include <bitcoin/bitcoin/machine/signature_queue.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 
 namespace libbitcoin {
@@ -56,13 +58,19 @@ public:
     program(const chain::script& script);
 
     /// Create an instance with empty stacks, value unused/max (input run).
+    /// Single signature checks are queued to deferred when it is not null.
+    /// Signature checks consult and populate cache when it is not null.
     program(const chain::script& script, const chain::transaction& transaction,
-        uint32_t input_index, uint32_t forks);
+        uint32_t input_index, uint32_t forks,
+        signature_queue* deferred=nullptr, signature_cache* cache=nullptr);
 
     /// Create an instance with initialized stack (witness run, v0 by default).
+    /// Single signature checks are queued to deferred when it is not null.
+    /// Signature checks consult and populate cache when it is not null.
     program(const chain::script& script, const chain::transaction& transaction,
         uint32_t input_index, uint32_t forks, data_stack&& stack,
-        uint64_t value, script_version version=script_version::zero);
+        uint64_t value, script_version version=script_version::zero,
+        signature_queue* deferred=nullptr, signature_cache* cache=nullptr);
 
     /// Create using copied tx, input, forks, value, stack (prevout run).
     program(const chain::script& script, const program& other);
@@ -77,6 +85,8 @@ public:
     uint64_t value() const;
     script_version version() const;
     const chain::transaction& transaction() const;
+    signature_queue* deferred() const;
+    signature_cache* cache() const;
 
     /// Program registers.
     op_iterator begin() const;
@@ -94,13 +104,14 @@ public:
     // Primary stack.
     //-------------------------------------------------------------------------
 
-    /// Primary push.
+    /// Primary push, copies reuse the buffers of dropped items.
     void push(bool value);
     void push_move(value_type&& item);
-    void push_copy(const value_type& item);
+    void push_copy(data_slice item);
 
     /// Primary pop.
     data_chunk pop();
+    void drop();
     bool pop(int32_t& out_value);
     bool pop(number& out_number, size_t maxiumum_size=max_number_size);
     bool pop_binary(number& first, number& second);
@@ -154,6 +165,8 @@ private:
     const uint32_t input_index_;
     const uint32_t forks_;
     const uint64_t value_;
+    signature_queue* const deferred_;
+    signature_cache* const cache_;
 
     script_version version_;
     size_t negative_count_;
@@ -161,6 +174,7 @@ private:
     op_iterator jump_;
     data_stack primary_;
     data_stack alternate_;
+    data_stack dropped_;
     bool_stack condition_;
 };
 
@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MACHINE_SIGNATURE_CACHE_HPP
+#define LIBBITCOIN_MACHINE_SIGNATURE_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/noncopyable.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+namespace machine {
+
+/// Thread safe, bounded cache of successful signature verifications.
+/// Entries are keyed by a salted sha256 of (sighash, signature, public key),
+/// so keys cannot be ground by a peer to collide. Storage is split into
+/// independently locked stripes that each evict the oldest entry when full.
+/// A cache is consulted only where passed, so consensus-critical validation
+/// bypasses it by passing none.
+class BC_API signature_cache
+  : noncopyable
+{
+public:
+    static const size_t default_size;
+
+    /// Construct a cache bounded to approximately the given memory size.
+    signature_cache(size_t maximum_bytes=default_size);
+
+    /// True if the verification is cached (counted as a hit or a miss).
+    bool contains(const hash_digest& sighash, data_slice public_key,
+        const ec_signature& signature) const;
+
+    /// Cache a successful verification.
+    void store(const hash_digest& sighash, data_slice public_key,
+        const ec_signature& signature);
+
+    /// Remove all entries, counters are not reset.
+    void clear();
+
+    size_t capacity() const;
+    size_t size() const;
+    size_t hits() const;
+    size_t misses() const;
+
+private:
+    // The key is uniformly distributed, so a prefix is a sufficient hash.
+    struct key_hasher
+    {
+        size_t operator()(const hash_digest& key) const;
+    };
+
+    typedef std::unordered_set<hash_digest, key_hasher> key_set;
+
+    struct stripe
+    {
+        key_set keys;
+        hash_list ring;
+        size_t next = 0;
+        mutable shared_mutex mutex;
+    };
+
+    hash_digest to_key(const hash_digest& sighash, data_slice public_key,
+        const ec_signature& signature) const;
+    stripe& to_stripe(const hash_digest& key) const;
+
+    const hash_digest salt_;
+    const size_t stripe_capacity_;
+    mutable std::vector<stripe> stripes_;
+    mutable std::atomic<size_t> hits_;
+    mutable std::atomic<size_t> misses_;
+};
+
+} // namespace machine
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_MACHINE_SIGNATURE_QUEUE_HPP
+#define LIBBITCOIN_MACHINE_SIGNATURE_QUEUE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/machine/signature_cache.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace machine {
+
+/// Signature checks deferred by the interpreter for later verification.
+/// Deferral is speculative, the interpreter proceeds as if each deferred
+/// check succeeded. So a script result obtained with deferral is valid only
+/// if every queued check verifies, otherwise the script must be rerun.
+class BC_API signature_queue
+{
+public:
+    /// Successfully verified checks are stored to cache when not null.
+    signature_queue(signature_cache* cache=nullptr);
+
+    /// Queue a signature check (the public key is not yet parsed).
+    void enqueue(data_chunk&& public_key, const hash_digest& sighash,
+        const ec_signature& signature);
+
+    bool empty() const;
+    size_t size() const;
+    void clear();
+
+    /// Verify the queued check at the given index.
+    bool verify(size_t index) const;
+
+    /// Verify all queued checks, false if any fails.
+    bool verify() const;
+
+private:
+    struct check
+    {
+        data_chunk public_key;
+        hash_digest sighash;
+        ec_signature signature;
+    };
+
+    signature_cache* cache_;
+    std::vector<check> checks_;
+};
+
+} // namespace machine
+} // namespace libbitcoin
+
+#endif
@@ -23,9 +23,9 @@
 #include <string>
 #include <vector>
 #include <boost/functional/hash_fwd.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
 #include <bitcoin/bitcoin/compat.hpp>
 #include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/uint256.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
 
@@ -55,9 +55,6 @@ typedef std::vector<long_hash> long_hash_list;
 typedef std::vector<short_hash> short_hash_list;
 typedef std::vector<mini_hash> mini_hash_list;
 
-// Alias for boost big integer type.
-typedef boost::multiprecision::uint256_t uint256_t;
-
 // Null-valued common bitcoin hashes.
 
 BC_CONSTEXPR hash_digest null_hash
@@ -109,7 +106,7 @@ BC_CONSTEXPR mini_hash null_mini_hash
 
 inline uint256_t to_uint256(const hash_digest& hash)
 {
-    return from_little_endian<uint256_t>(hash.begin(), hash.end());
+    return uint256_t(hash);
 }
 
 /// Generate a scrypt hash to fill a byte array.
@@ -124,6 +121,15 @@ BC_API data_chunk scrypt(data_slice data, data_slice salt, uint64_t N,
 /// Generate a bitcoin hash.
 BC_API hash_digest bitcoin_hash(data_slice data);
 
+/// Generate the bitcoin hash of each adjacent pair of hashes (a merkle row).
+/// The input must be of even size and the output is resized to half of it.
+/// The output may be the input list, in which case it is reduced in place.
+BC_API void bitcoin_hash_pairs(hash_list& out, const hash_list& in);
+
+/// Generate the bitcoin hash of the concatenation of two hashes.
+BC_API hash_digest bitcoin_hash(const hash_digest& left,
+    const hash_digest& right);
+
 /// Generate a bitcoin short hash.
 BC_API short_hash bitcoin_short_hash(data_slice data);
 
@@ -16,14 +16,123 @@
  * You should have received a copy of the GNU Affero General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
-#ifndef LIBBBITCOIN_UINT256_HPP
-#define LIBBBITCOIN_UINT256_HPP
+#ifndef LIBBITCOIN_UINT256_HPP
+#define LIBBITCOIN_UINT256_HPP
 
-#include <boost/multiprecision/cpp_int.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <bitcoin/bitcoin/compat.hpp>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
 
 namespace libbitcoin {
 
+/// A fixed-width unsigned 256 bit integer held on the stack.
+/// Arithmetic is modulo 2^256, as with the built-in unsigned types.
+/// The hash conversions treat the hash as a little-endian number, which is
+/// consistent with proof-of-work target comparison.
+class BC_API uint256_t
+{
+public:
+    static BC_CONSTEXPR size_t word_bits = 32;
+    static BC_CONSTEXPR size_t word_count = 8;
 
+    /// Constructors.
+    //-------------------------------------------------------------------------
+
+    BC_CONSTCTOR uint256_t()
+      : words_{ { 0, 0, 0, 0, 0, 0, 0, 0 } }
+    {
+    }
+
+    BC_CONSTCTOR uint256_t(uint64_t value)
+      : words_{ { static_cast<uint32_t>(value),
+            static_cast<uint32_t>(value >> word_bits), 0, 0, 0, 0, 0, 0 } }
+    {
+    }
+
+    /// The hash is interpreted as a little-endian number.
+    explicit uint256_t(const byte_array<32>& hash);
+
+    /// Properties.
+    //-------------------------------------------------------------------------
+
+    /// The little-endian serialization of the number.
+    byte_array<32> hash() const;
+
+    /// The number of significant bits (zero for zero).
+    size_t bit_length() const;
+
+    /// The number of significant bytes (zero for zero).
+    size_t byte_length() const;
+
+    /// The 64 bit limb at the index (0 is least significant), zero if beyond.
+    uint64_t operator[](size_t index) const;
+
+    /// The least significant 64 bits.
+    explicit operator uint64_t() const;
+
+    /// Unary operators.
+    //-------------------------------------------------------------------------
+
+    uint256_t operator~() const;
+    uint256_t operator-() const;
+    uint256_t& operator++();
+
+    /// Assignment operators.
+    //-------------------------------------------------------------------------
+
+    uint256_t& operator<<=(uint32_t shift);
+    uint256_t& operator>>=(uint32_t shift);
+    uint256_t& operator+=(const uint256_t& other);
+    uint256_t& operator-=(const uint256_t& other);
+    uint256_t& operator*=(uint32_t value);
+    uint256_t& operator*=(const uint256_t& other);
+
+    /// Throws std::overflow_error on division by zero.
+    uint256_t& operator/=(uint32_t value);
+
+    /// Throws std::overflow_error on division by zero.
+    uint256_t& operator/=(const uint256_t& other);
+
+    /// Comparison.
+    //-------------------------------------------------------------------------
+
+    /// Returns -1, 0 or 1 as this is less than, equal to or greater than.
+    int compare(const uint256_t& other) const;
+
+    /// The decimal representation of the number.
+    std::string to_string() const;
+
+private:
+    // Divide in place by a non-zero value and return the remainder.
+    uint32_t divide(uint32_t value);
+
+    // Least significant word first.
+    std::array<uint32_t, word_count> words_;
+};
+
+BC_API bool operator==(const uint256_t& left, const uint256_t& right);
+BC_API bool operator!=(const uint256_t& left, const uint256_t& right);
+BC_API bool operator<(const uint256_t& left, const uint256_t& right);
+BC_API bool operator>(const uint256_t& left, const uint256_t& right);
+BC_API bool operator<=(const uint256_t& left, const uint256_t& right);
+BC_API bool operator>=(const uint256_t& left, const uint256_t& right);
+
+BC_API uint256_t operator<<(const uint256_t& left, uint32_t shift);
+BC_API uint256_t operator>>(const uint256_t& left, uint32_t shift);
+BC_API uint256_t operator+(const uint256_t& left, const uint256_t& right);
+BC_API uint256_t operator-(const uint256_t& left, const uint256_t& right);
+BC_API uint256_t operator*(const uint256_t& left, uint32_t right);
+BC_API uint256_t operator*(const uint256_t& left, const uint256_t& right);
+BC_API uint256_t operator/(const uint256_t& left, uint32_t right);
+BC_API uint256_t operator/(const uint256_t& left, const uint256_t& right);
+
+/// Writes the decimal representation of the number.
+BC_API std::ostream& operator<<(std::ostream& output, const uint256_t& value);
 
 } // namespace libbitcoin
 
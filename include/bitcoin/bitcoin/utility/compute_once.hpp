@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_COMPUTE_ONCE_HPP
+#define LIBBITCOIN_COMPUTE_ONCE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace libbitcoin {
+
+/// A lazily computed value held inline and published once without a lock.
+/// Reading a published value is a single acquire load. The first reader of
+/// an empty value computes it, concurrent readers wait for that computation.
+/// Assignment and reset are not safe concurrent with get, consistent with
+/// the (unguarded) mutation of the objects that own these caches.
+template <typename Type>
+class compute_once
+{
+public:
+    /// Create an empty cache.
+    compute_once()
+      : value_(), state_(empty)
+    {
+    }
+
+    /// Create a cache with a published value.
+    compute_once(const Type& value)
+      : value_(value), state_(ready)
+    {
+    }
+
+    /// Copy the published value, if any.
+    compute_once(const compute_once& other)
+      : compute_once()
+    {
+        *this = other;
+    }
+
+    /// Move the published value, if any.
+    compute_once(compute_once&& other)
+      : compute_once()
+    {
+        *this = std::move(other);
+    }
+
+    /// Move the published value, if any.
+    compute_once& operator=(compute_once&& other)
+    {
+        if (other.state_.load(std::memory_order_acquire) == ready)
+        {
+            value_ = std::move(other.value_);
+            state_.store(ready, std::memory_order_release);
+            other.reset();
+        }
+        else
+        {
+            reset();
+        }
+
+        return *this;
+    }
+
+    /// Copy the published value, if any.
+    compute_once& operator=(const compute_once& other)
+    {
+        if (other.state_.load(std::memory_order_acquire) == ready)
+        {
+            value_ = other.value_;
+            state_.store(ready, std::memory_order_release);
+        }
+        else
+        {
+            reset();
+        }
+
+        return *this;
+    }
+
+    /// True if the value has been published.
+    bool is_set() const
+    {
+        return state_.load(std::memory_order_acquire) == ready;
+    }
+
+    /// The published value, computed by the function if not yet published.
+    template <typename Function>
+    const Type& get(Function compute) const
+    {
+        while (true)
+        {
+            auto state = state_.load(std::memory_order_acquire);
+
+            if (state == ready)
+                return value_;
+
+            if (state == empty && state_.compare_exchange_strong(state, busy,
+                std::memory_order_acquire))
+            {
+                try
+                {
+                    value_ = compute();
+                }
+                catch (...)
+                {
+                    state_.store(empty, std::memory_order_release);
+                    throw;
+                }
+
+                state_.store(ready, std::memory_order_release);
+                return value_;
+            }
+
+            // Another thread is computing the value (computation is brief).
+            std::this_thread::yield();
+        }
+    }
+
+    /// Publish the value.
+    void set(const Type& value)
+    {
+        value_ = value;
+        state_.store(ready, std::memory_order_release);
+    }
+
+    /// Publish the value.
+    void set(Type&& value)
+    {
+        value_ = std::move(value);
+        state_.store(ready, std::memory_order_release);
+    }
+
+    /// Clear the value (releasing any resources), it will be recomputed on
+    /// the next get.
+    void reset()
+    {
+        state_.store(empty, std::memory_order_release);
+        value_ = Type();
+    }
+
+private:
+    static const uint8_t empty = 0;
+    static const uint8_t busy = 1;
+    static const uint8_t ready = 2;
+
+    mutable Type value_;
+    mutable std::atomic<uint8_t> state_;
+};
+
+} // namespace libbitcoin
+
+#endif
@@ -31,8 +31,9 @@
 namespace libbitcoin {
 
 /// Reader to wrap arbitrary iterator.
+/// Final so that calls through the concrete type are not virtual.
 template <typename Iterator, bool CheckSafe>
-class deserializer
+class deserializer final
   : public reader/*, noncopyable*/
 {
 public:
@@ -108,6 +109,10 @@ private:
     const Iterator end_;
 };
 
+/// Bounds checked reader over contiguous memory, the chain types provide
+/// non-virtual deserialization overloads for this reader.
+typedef deserializer<const uint8_t*, true> byte_deserializer;
+
 // Factories.
 //-----------------------------------------------------------------------------
 
@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_FLAT_HASH_SET_HPP
+#define LIBBITCOIN_FLAT_HASH_SET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libbitcoin {
+
+/**
+ * An insert-only open addressing set held in a preallocated flat table.
+ *
+ * The hasher must return a uniformly distributed 64 bit value, such as a
+ * salted mix of a (uniformly random) hash digest key. Slots are linearly
+ * probed from the high bits of that value and each slot caches it, so that
+ * most probes are resolved without a key comparison. The table is sized on
+ * construction for the expected number of keys at a load of one half, and
+ * doubles if that is exceeded. This is not thread safe.
+ */
+template <typename Key, typename Hasher>
+class flat_hash_set
+{
+public:
+    /// Construct a set with room for the expected number of keys.
+    flat_hash_set(size_t expected=0, const Hasher& hasher=Hasher());
+
+    /// Insert the key, false if it was already present.
+    bool insert(const Key& key);
+
+    /// True if the key is present.
+    bool contains(const Key& key) const;
+
+    /// Remove all keys, retaining the table.
+    void clear();
+
+    size_t size() const;
+    bool empty() const;
+
+private:
+    static size_t to_shift(size_t expected);
+
+    size_t find(const Key& key, uint64_t tag) const;
+    void grow();
+
+    Hasher hasher_;
+    size_t shift_;
+    size_t size_;
+    std::vector<uint64_t> tags_;
+    std::vector<Key> keys_;
+};
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/flat_hash_set.ipp>
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_PARALLEL_HPP
+#define LIBBITCOIN_PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+/// Handler returns false to stop processing of all greater indexes.
+typedef std::function<bool(size_t index)> parallel_handler;
+
+/**
+ * Invoke the handler for each index in [0, count) on the threadpool threads
+ * and the calling thread, blocking the caller until all indexes complete.
+ * Indexes are claimed in ascending batches of the specified size, so an empty
+ * (or fully blocked) pool degrades to serial execution on the calling thread.
+ * @param[in]   pool     The threadpool on which to dispatch batches.
+ * @param[in]   count    The number of indexes to process.
+ * @param[in]   batch    The number of consecutive indexes in each batch.
+ * @param[in]   handler  The handler invoked for each index.
+ * @return      The lowest index for which the handler returned false, or
+ *              count if the handler returned true for all indexes. This is
+ *              deterministic and matches the result of serial execution.
+ */
+BC_API size_t parallel_for(threadpool& pool, size_t count, size_t batch,
+    parallel_handler handler);
+
+} // namespace libbitcoin
+
+#endif
@@ -31,8 +31,9 @@
 namespace libbitcoin {
 
 /// Writer to wrap arbitrary iterator.
+/// Final so that calls through the concrete type are not virtual.
 template <typename Iterator>
-class serializer
+class serializer final
   : public writer/*, noncopyable*/
 {
 public:
@@ -111,6 +112,10 @@ private:
     Iterator iterator_;
 };
 
+/// Unchecked writer over presized contiguous memory, the chain types provide
+/// non-virtual serialization overloads for this writer.
+typedef serializer<uint8_t*> byte_serializer;
+
 // Factories.
 //-----------------------------------------------------------------------------
 
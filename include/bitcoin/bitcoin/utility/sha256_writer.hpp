@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SHA256_WRITER_HPP
+#define LIBBITCOIN_SHA256_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin/define.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/writer.hpp>
+
+namespace libbitcoin {
+
+/// Writer that streams bytes into an incremental sha256 context, allowing
+/// serializable objects to be hashed without materializing their encoding.
+/// A digest may be obtained only once, after which the writer is invalid.
+class BC_API sha256_writer
+  : public writer
+{
+public:
+    sha256_writer();
+
+    /// The sha256 hash of the written bytes (invalidates the writer).
+    hash_digest sha256_hash();
+
+    /// The double sha256 hash of the written bytes (invalidates the writer).
+    hash_digest bitcoin_hash();
+
+    /// Context.
+    operator bool() const;
+    bool operator!() const;
+
+    /// Write hashes.
+    void write_hash(const hash_digest& value);
+    void write_short_hash(const short_hash& value);
+    void write_mini_hash(const mini_hash& value);
+
+    /// Write big endian integers.
+    void write_2_bytes_big_endian(uint16_t value);
+    void write_4_bytes_big_endian(uint32_t value);
+    void write_8_bytes_big_endian(uint64_t value);
+    void write_variable_big_endian(uint64_t value);
+    void write_size_big_endian(size_t value);
+
+    /// Write little endian integers.
+    void write_2_bytes_little_endian(uint16_t value);
+    void write_4_bytes_little_endian(uint32_t value);
+    void write_8_bytes_little_endian(uint64_t value);
+    void write_variable_little_endian(uint64_t value);
+    void write_size_little_endian(size_t value);
+
+    /// Write one byte.
+    void write_byte(uint8_t value);
+
+    /// Write all bytes.
+    void write_bytes(const data_chunk& data);
+
+    /// Write required size buffer.
+    void write_bytes(const uint8_t* data, size_t size);
+
+    /// Write variable length string.
+    void write_string(const std::string& value);
+
+    /// Write required length string, padded with nulls.
+    void write_string(const std::string& value, size_t size);
+
+    /// Write nulls, as a hash has no position to advance.
+    void skip(size_t size);
+
+private:
+    // This mirrors the layout of the (unexported) sha256 context.
+    struct context
+    {
+        uint32_t state[8];
+        uint32_t count[2];
+        uint8_t buffer[64];
+    };
+
+    context context_;
+    bool valid_;
+};
+
+} // namespace libbitcoin
+
+#endif
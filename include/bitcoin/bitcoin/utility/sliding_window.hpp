@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_SLIDING_WINDOW_HPP
+#define LIBBITCOIN_SLIDING_WINDOW_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace libbitcoin {
+
+/**
+ * A contiguous FIFO sequence that is advanced by push_back and pop_front.
+ *
+ * Values are held in a single buffer and popping only advances the start of
+ * the window, so a full window is advanced in amortized constant time with no
+ * allocation once the buffer has grown to twice the window size. Unlike a
+ * modular ring buffer the values remain contiguous, so iterators are pointers
+ * and the window can be sorted, resized and iterated like a vector.
+ */
+template <typename Type>
+class sliding_window
+{
+public:
+    typedef Type value_type;
+    typedef Type* iterator;
+    typedef const Type* const_iterator;
+    typedef Type& reference;
+    typedef const Type& const_reference;
+    typedef std::size_t size_type;
+
+    sliding_window();
+    sliding_window(std::initializer_list<Type> values);
+
+    /// Copies reserve room to advance without reallocation.
+    sliding_window(const sliding_window& other);
+    sliding_window(sliding_window&& other);
+
+    sliding_window& operator=(const sliding_window& other);
+    sliding_window& operator=(sliding_window&& other);
+
+    bool operator==(const sliding_window& other) const;
+    bool operator!=(const sliding_window& other) const;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    reference front();
+    reference back();
+    const_reference front() const;
+    const_reference back() const;
+
+    reference operator[](size_type index);
+    const_reference operator[](size_type index) const;
+
+    size_type size() const;
+    bool empty() const;
+
+    void clear();
+    void resize(size_type size);
+    void push_back(Type value);
+    void pop_front();
+
+private:
+    void compact();
+
+    std::vector<Type> buffer_;
+    size_type start_;
+};
+
+} // namespace libbitcoin
+
+#include <bitcoin/bitcoin/impl/utility/sliding_window.ipp>
+
+#endif
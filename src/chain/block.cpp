@@ -43,6 +43,9 @@
 #include <bitcoin/bitcoin/machine/number.hpp>
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/rule_fork.hpp>
+#include <bitcoin/bitcoin/machine/script_cache.hpp>
+#include <bitcoin/bitcoin/machine/signature_cache.hpp>
+#include <bitcoin/bitcoin/machine/signature_queue.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/utility/asio.hpp>
 #include <bitcoin/bitcoin/utility/assert.hpp>
@@ -50,6 +53,8 @@
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -58,6 +63,9 @@ using namespace bc::config;
 using namespace bc::machine;
 using namespace boost::adaptors;
 
+// The number of inputs claimed by a thread for each parallel connect batch.
+static constexpr size_t connect_batch_size = 16;
+
 static const std::string encoded_mainnet_genesis_block =
     "01000000"
     "0000000000000000000000000000000000000000000000000000000000000000"
@@ -123,24 +131,27 @@ static const std::string encoded_regtest_genesis_block =
 
 block::block()
   : header_{},
+    stripped_(false),
     validation{}
 {
 }
 
 block::block(const block& other)
-  : total_inputs_(other.total_inputs_cache()),
-    non_coinbase_inputs_(other.non_coinbase_inputs_cache()),
+  : total_inputs_(other.total_inputs_),
+    non_coinbase_inputs_(other.non_coinbase_inputs_),
     header_(other.header_),
     transactions_(other.transactions_),
+    stripped_(other.stripped_),
     validation(other.validation)
 {
 }
 
 block::block(block&& other)
-  : total_inputs_(other.total_inputs_cache()),
-    non_coinbase_inputs_(other.non_coinbase_inputs_cache()),
+  : total_inputs_(other.total_inputs_),
+    non_coinbase_inputs_(other.non_coinbase_inputs_),
     header_(std::move(other.header_)),
     transactions_(std::move(other.transactions_)),
+    stripped_(other.stripped_),
     validation(other.validation)
 {
 }
@@ -149,6 +160,7 @@ block::block(const chain::header& header,
     const transaction::list& transactions)
   : header_(header),
     transactions_(transactions),
+    stripped_(false),
     validation{}
 {
 }
@@ -156,31 +168,21 @@ block::block(const chain::header& header,
 block::block(chain::header&& header, transaction::list&& transactions)
   : header_(std::move(header)),
     transactions_(std::move(transactions)),
+    stripped_(false),
     validation{}
 {
 }
 
-block::optional_size block::total_inputs_cache() const
-{
-    shared_lock lock(mutex_);
-    return total_inputs_;
-}
-
-block::optional_size block::non_coinbase_inputs_cache() const
-{
-    shared_lock lock(mutex_);
-    return non_coinbase_inputs_;
-}
-
 // Operators.
 //-----------------------------------------------------------------------------
 
 block& block::operator=(block&& other)
 {
-    total_inputs_ = other.total_inputs_cache();
-    non_coinbase_inputs_ = other.non_coinbase_inputs_cache();
+    total_inputs_ = other.total_inputs_;
+    non_coinbase_inputs_ = other.non_coinbase_inputs_;
     header_ = std::move(other.header_);
     transactions_ = std::move(other.transactions_);
+    stripped_ = other.stripped_;
     validation = std::move(other.validation);
     return *this;
 }
@@ -224,8 +226,9 @@ block block::factory(reader& source, bool witness)
 
 bool block::from_data(const data_chunk& data, bool witness)
 {
-    data_source istream(data);
-    return from_data(istream, witness);
+    const auto begin = data.data();
+    auto source = make_safe_deserializer(begin, begin + data.size());
+    return from_data(source, witness);
 }
 
 bool block::from_data(std::istream& stream, bool witness)
@@ -235,7 +238,9 @@ bool block::from_data(std::istream& stream, bool witness)
 }
 
 // Full block deserialization is always canonical encoding.
-bool block::from_data(reader& source, bool witness)
+// private
+template <class Source>
+bool block::deserialize(Source& source, bool witness)
 {
     validation.start_deserialize = asio::steady_clock::now();
     reset();
@@ -267,6 +272,16 @@ bool block::from_data(reader& source, bool witness)
     return source;
 }
 
+bool block::from_data(reader& source, bool witness)
+{
+    return deserialize(source, witness);
+}
+
+bool block::from_data(byte_deserializer& source, bool witness)
+{
+    return deserialize(source, witness);
+}
+
 // private
 void block::reset()
 {
@@ -285,13 +300,9 @@ bool block::is_valid() const
 
 data_chunk block::to_data(bool witness) const
 {
-    data_chunk data;
-    const auto size = serialized_size(witness);
-    data.reserve(size);
-    data_sink ostream(data);
-    to_data(ostream);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
+    data_chunk data(serialized_size(witness));
+    auto sink = make_unsafe_serializer(data.data());
+    to_data(sink, witness);
     return data;
 }
 
@@ -302,7 +313,9 @@ void block::to_data(std::ostream& stream, bool witness) const
 }
 
 // Full block serialization is always canonical encoding.
-void block::to_data(writer& sink, bool witness) const
+// private
+template <class Sink>
+void block::serialize(Sink& sink, bool witness) const
 {
     header_.to_data(sink, true);
     sink.write_size_little_endian(transactions_.size());
@@ -314,6 +327,16 @@ void block::to_data(writer& sink, bool witness) const
     std::for_each(transactions_.begin(), transactions_.end(), to);
 }
 
+void block::to_data(writer& sink, bool witness) const
+{
+    serialize(sink, witness);
+}
+
+void block::to_data(byte_serializer& sink, bool witness) const
+{
+    serialize(sink, witness);
+}
+
 hash_list block::to_hashes(bool witness) const
 {
     hash_list out;
@@ -334,50 +357,20 @@ hash_list block::to_hashes(bool witness) const
 // Full block serialization is always canonical encoding.
 size_t block::serialized_size(bool witness) const
 {
-    size_t value;
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (witness && total_size_ != boost::none)
-    {
-        value = total_size_.get();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    if (!witness && base_size_ != boost::none)
+    const auto size = [this, witness]()
     {
-        value = base_size_.get();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
-    const auto sum = [witness](size_t total, const transaction& tx)
-    {
-        return safe_add(total, tx.serialized_size(true, witness));
+        const auto sum = [witness](size_t total, const transaction& tx)
+        {
+            return safe_add(total, tx.serialized_size(true, witness));
+        };
+
+        const auto& txs = transactions_;
+        return header_.serialized_size(true) +
+            message::variable_uint_size(transactions_.size()) +
+            std::accumulate(txs.begin(), txs.end(), size_t(0), sum);
     };
 
-    const auto& txs = transactions_;
-    value = header_.serialized_size(true) +
-        message::variable_uint_size(transactions_.size()) +
-        std::accumulate(txs.begin(), txs.end(), size_t(0), sum);
-
-    if (witness)
-        total_size_ = value;
-    else
-        base_size_ = value;
-
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
+    return witness ? total_size_.get(size) : base_size_.get(size);
 }
 
 chain::header& block::header()
@@ -409,21 +402,21 @@ const transaction::list& block::transactions() const
 void block::set_transactions(const transaction::list& value)
 {
     transactions_ = value;
-    segregated_ = boost::none;
-    total_inputs_ = boost::none;
-    non_coinbase_inputs_ = boost::none;
-    base_size_ = boost::none;
-    total_size_ = boost::none;
+    stripped_ = false;
+    total_inputs_.reset();
+    non_coinbase_inputs_.reset();
+    base_size_.reset();
+    total_size_.reset();
 }
 
 void block::set_transactions(transaction::list&& value)
 {
     transactions_ = std::move(value);
-    segregated_ = boost::none;
-    total_inputs_ = boost::none;
-    non_coinbase_inputs_ = boost::none;
-    base_size_ = boost::none;
-    total_size_ = boost::none;
+    stripped_ = false;
+    total_inputs_.reset();
+    non_coinbase_inputs_.reset();
+    base_size_.reset();
+    total_size_.reset();
 }
 
 // Convenience property.
@@ -522,14 +515,9 @@ void block::strip_witness()
         transaction.strip_witness();
     };
 
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    unique_lock lock(mutex_);
-
-    segregated_ = false;
-    total_size_ = boost::none;
+    stripped_ = true;
+    total_size_.reset();
     std::for_each(transactions_.begin(), transactions_.end(), strip);
-    ///////////////////////////////////////////////////////////////////////////
 }
 
 // Validation helpers.
@@ -603,70 +591,30 @@ size_t block::signature_operations(bool bip16, bool bip141) const
 
 size_t block::total_non_coinbase_inputs() const
 {
-    size_t value;
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (non_coinbase_inputs_ != boost::none)
-    {
-        value = non_coinbase_inputs_.get();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
     const auto inputs = [](size_t total, const transaction& tx)
     {
         return safe_add(total, tx.inputs().size());
     };
 
-    const auto& txs = transactions_;
-    value = std::accumulate(txs.begin() + 1, txs.end(), size_t(0), inputs);
-    non_coinbase_inputs_ = value;
-
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
+    return non_coinbase_inputs_.get([this, &inputs]()
+    {
+        const auto& txs = transactions_;
+        return std::accumulate(txs.begin() + 1, txs.end(), size_t(0), inputs);
+    });
 }
 
 size_t block::total_inputs() const
 {
-    size_t value;
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (total_inputs_ != boost::none)
-    {
-        value = total_inputs_.get();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
     const auto inputs = [](size_t total, const transaction& tx)
     {
         return safe_add(total, tx.inputs().size());
     };
 
-    const auto& txs = transactions_;
-    value = std::accumulate(txs.begin(), txs.end(), size_t(0), inputs);
-    total_inputs_ = value;
-
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
+    return total_inputs_.get([this, &inputs]()
+    {
+        const auto& txs = transactions_;
+        return std::accumulate(txs.begin(), txs.end(), size_t(0), inputs);
+    });
 }
 
 size_t block::weight() const
@@ -720,23 +668,16 @@ hash_digest block::generate_merkle_root(bool witness) const
     if (transactions_.empty())
         return null_hash;
 
-    hash_list update;
     auto merkle = to_hashes(witness);
 
-    // Initial capacity is half of the original list (clear doesn't reset).
-    update.reserve((merkle.size() + 1) / 2);
-
     while (merkle.size() > 1)
     {
         // If number of hashes is odd, duplicate last hash in the list.
         if (merkle.size() % 2 != 0)
             merkle.push_back(merkle.back());
 
-        for (auto it = merkle.begin(); it != merkle.end(); it += 2)
-            update.push_back(bitcoin_hash(build_chunk({ it[0], it[1] })));
-
-        std::swap(merkle, update);
-        update.clear();
+        // Each row is hashed in place as a batch of 64 byte blocks.
+        bitcoin_hash_pairs(merkle, merkle);
     }
 
     // There is now only one item in the list.
@@ -847,7 +788,7 @@ bool block::is_valid_witness_commitment() const
         for (const auto& output: reverse(coinbase.outputs()))
             if (output.extract_committed_hash(committed))
                 return committed == bitcoin_hash(
-                    build_chunk({ generate_merkle_root(true), reserved }));
+                    generate_merkle_root(true), reserved);
 
     // If no txs in block are segregated the commitment is optional (bip141).
     return !is_segregated();
@@ -855,22 +796,9 @@ bool block::is_valid_witness_commitment() const
 
 bool block::is_segregated() const
 {
-    bool value;
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (segregated_ != boost::none)
-    {
-        value = segregated_.get();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    // Not cached, since witnesses are mutable through transactions.
+    if (stripped_)
+        return false;
 
     const auto segregated = [](const transaction& tx)
     {
@@ -878,12 +806,7 @@ bool block::is_segregated() const
     };
 
     // If no block tx has witness data the commitment is optional (bip141).
-    value = std::any_of(transactions_.begin(), transactions_.end(), segregated);
-
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
+    return std::any_of(transactions_.begin(), transactions_.end(), segregated);
 }
 
 code block::check_transactions() const
@@ -908,17 +831,82 @@ code block::accept_transactions(const chain_state& state) const
     return error::success;
 }
 
-code block::connect_transactions(const chain_state& state) const
+code block::connect_transactions(const chain_state& state,
+    signature_cache* cache, script_cache* scripts) const
 {
     code ec;
 
     for (const auto& tx: transactions_)
-        if ((ec = tx.connect(state)))
+        if ((ec = tx.connect(state, cache, scripts)))
             return ec;
 
     return error::success;
 }
 
+code block::connect_transactions(const chain_state& state,
+    threadpool& pool, signature_cache* cache, script_cache* scripts) const
+{
+    typedef std::pair<const transaction*, size_t> input_reference;
+    std::vector<input_reference> inputs;
+    inputs.reserve(total_non_coinbase_inputs());
+    const auto forks = state.enabled_forks();
+
+    // Flatten in block order so that the lowest failure matches serial.
+    // Coinbase inputs are skipped as they always connect (no prevouts).
+    // Inputs of cached txs are skipped as their scripts are known valid.
+    for (const auto& tx: transactions_)
+        if (!tx.is_coinbase() && (scripts == nullptr ||
+            !scripts->contains(tx.hash(true), forks)))
+            for (size_t index = 0; index < tx.inputs().size(); ++index)
+                inputs.emplace_back(&tx, index);
+
+    std::vector<code> results(inputs.size(), error::success);
+    std::vector<signature_queue> deferred(inputs.size(),
+        signature_queue(cache));
+
+    // Evaluate all scripts, with single signature checks deferred. A failure
+    // here may be caused by speculation, so it does not stop evaluation.
+    const auto evaluate = [&](size_t index)
+    {
+        const auto& input = inputs[index];
+        results[index] = input.first->connect_input(state, input.second,
+            &deferred[index], cache);
+        return true;
+    };
+
+    parallel_for(pool, inputs.size(), connect_batch_size, evaluate);
+
+    // Verify the deferred signatures of each speculatively connected input.
+    // Any other input is suspect and is connected again without deferral,
+    // which produces the exact (serial) result for the lowest suspect input.
+    for (size_t start = 0; start < inputs.size(); ++start)
+    {
+        const auto verify = [&](size_t index)
+        {
+            return !results[start + index] && deferred[start + index].verify();
+        };
+
+        start += parallel_for(pool, inputs.size() - start,
+            connect_batch_size, verify);
+
+        if (start == inputs.size())
+            break;
+
+        const auto& input = inputs[start];
+        const auto ec = input.first->connect_input(state, input.second,
+            nullptr, cache);
+
+        if (ec)
+            return ec;
+    }
+
+    if (scripts != nullptr)
+        for (const auto& tx: transactions_)
+            scripts->store(tx.hash(true), forks);
+
+    return error::success;
+}
+
 // Validation.
 //-----------------------------------------------------------------------------
 
@@ -1038,7 +1026,20 @@ code block::connect() const
     return state ? connect(*state) : error::operation_failed;
 }
 
-code block::connect(const chain_state& state) const
+code block::connect(const chain_state& state, signature_cache* cache,
+    script_cache* scripts) const
+{
+    validation.start_connect = asio::steady_clock::now();
+
+    if (state.is_under_checkpoint())
+        return error::success;
+
+    else
+        return connect_transactions(state, cache, scripts);
+}
+
+code block::connect(const chain_state& state, threadpool& pool,
+    signature_cache* cache, script_cache* scripts) const
 {
     validation.start_connect = asio::steady_clock::now();
 
@@ -1046,7 +1047,7 @@ code block::connect(const chain_state& state) const
         return error::success;
 
     else
-        return connect_transactions(state);
+        return connect_transactions(state, pool, cache, scripts);
 }
 
 } // namespace chain
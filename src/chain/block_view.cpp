@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/block_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <bitcoin/bitcoin/chain/block.hpp>
+#include <bitcoin/bitcoin/chain/header.hpp>
+#include <bitcoin/bitcoin/chain/transaction_view.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+static const auto header_size = header::satoshi_fixed_size();
+
+block_view::block_view(data_slice buffer)
+  : begin_(buffer.begin()),
+    end_(buffer.end()),
+    valid_(false)
+{
+    valid_ = parse();
+
+    if (!valid_)
+    {
+        end_ = begin_;
+        transactions_.clear();
+    }
+}
+
+// Moving the chunk into shared storage preserves its data pointer.
+block_view::block_view(data_chunk&& buffer)
+  : buffer_(std::make_shared<const data_chunk>(std::move(buffer))),
+    begin_(buffer_->data()),
+    end_(begin_ + buffer_->size()),
+    valid_(false)
+{
+    valid_ = parse();
+
+    if (!valid_)
+    {
+        end_ = begin_;
+        transactions_.clear();
+    }
+}
+
+bool block_view::parse()
+{
+    auto it = begin_;
+    const auto remaining = [&]()
+    {
+        return static_cast<size_t>(end_ - it);
+    };
+
+    if (remaining() < header_size + 1)
+        return false;
+
+    it += header_size;
+
+    // The transaction count must be minimally encoded (see transaction_view).
+    uint64_t count = *it++;
+    size_t width = 0;
+
+    switch (count)
+    {
+        case varint_two_bytes:
+            width = sizeof(uint16_t);
+            break;
+        case varint_four_bytes:
+            width = sizeof(uint32_t);
+            break;
+        case varint_eight_bytes:
+            width = sizeof(uint64_t);
+            break;
+        default:
+            break;
+    }
+
+    if (width != 0)
+    {
+        if (remaining() < width)
+            return false;
+
+        uint64_t minimum;
+
+        if (width == sizeof(uint16_t))
+        {
+            count = from_little_endian_unsafe<uint16_t>(it);
+            minimum = varint_two_bytes;
+        }
+        else if (width == sizeof(uint32_t))
+        {
+            count = from_little_endian_unsafe<uint32_t>(it);
+            minimum = uint64_t(max_uint16) + 1;
+        }
+        else
+        {
+            count = from_little_endian_unsafe<uint64_t>(it);
+            minimum = uint64_t(max_uint32) + 1;
+        }
+
+        if (count < minimum)
+            return false;
+
+        it += width;
+    }
+
+    // Guard against potential for arbitary memory allocation.
+    if (count > max_block_size)
+        return false;
+
+    transactions_.reserve(static_cast<size_t>(count));
+
+    for (size_t tx = 0; tx < count; ++tx)
+    {
+        transaction_view view({ it, end_ });
+
+        if (!view.is_valid())
+            return false;
+
+        it += view.serialized_size();
+        transactions_.push_back(std::move(view));
+    }
+
+    end_ = it;
+    return true;
+}
+
+bool block_view::is_valid() const
+{
+    return valid_;
+}
+
+data_slice block_view::data() const
+{
+    return{ begin_, end_ };
+}
+
+size_t block_view::serialized_size() const
+{
+    return static_cast<size_t>(end_ - begin_);
+}
+
+data_slice block_view::header_data() const
+{
+    BITCOIN_ASSERT(valid_);
+    return{ begin_, begin_ + header_size };
+}
+
+hash_digest block_view::hash() const
+{
+    return bitcoin_hash(header_data());
+}
+
+chain::header block_view::to_header() const
+{
+    return header::factory(to_chunk(header_data()));
+}
+
+const transaction_view::list& block_view::transactions() const
+{
+    return transactions_;
+}
+
+block block_view::to_block(bool witness) const
+{
+    BITCOIN_ASSERT(valid_);
+    return block::factory(to_chunk(data()), witness);
+}
+
+} // namespace chain
+} // namespace libbitcoin
@@ -160,6 +160,15 @@ inline bool bip65(size_t height, bool frozen, bool mainnet, bool testnet)
          (regtest && height >= regtest_bip65_freeze));
 }
 
+//*****************************************************************************
+// CONSENSUS: Though unspecified in bip34, the satoshi implementation
+// performed this comparison using the signed integer version value.
+//*****************************************************************************
+inline bool is_version_at_least(uint32_t value, size_t version)
+{
+    return static_cast<int32_t>(value) >= version;
+}
+
 inline uint32_t timestamp_high(const chain_state::data& values)
 {
     return values.timestamp.ordered.back();
@@ -175,33 +184,24 @@ inline uint32_t bits_high(const chain_state::data& values)
 
 chain_state::activations chain_state::activation(const data& values,
     uint32_t forks)
+{
+    return activation(values, to_tally(values), forks);
+}
+
+chain_state::activations chain_state::activation(const data& values,
+    const tally& counts, uint32_t forks)
 {
     const auto height = values.height;
     const auto version = values.version.self;
-    const auto& history = values.version.ordered;
     const auto frozen = script::is_enabled(forks, rule_fork::bip90_rule);
     const auto testnet = script::is_enabled(forks, rule_fork::easy_blocks);
     const auto retarget = script::is_enabled(forks, rule_fork::retarget);
     const auto mainnet = retarget && !testnet;
 
-    //*************************************************************************
-    // CONSENSUS: Though unspecified in bip34, the satoshi implementation
-    // performed this comparison using the signed integer version value.
-    //*************************************************************************
-    const auto ge = [](uint32_t value, size_t version)
-    {
-        return static_cast<int32_t>(value) >= version;
-    };
-
-    // Declare bip34-based version predicates.
-    const auto ge_2 = [=](uint32_t value) { return ge(value, bip34_version); };
-    const auto ge_3 = [=](uint32_t value) { return ge(value, bip66_version); };
-    const auto ge_4 = [=](uint32_t value) { return ge(value, bip65_version); };
-
-    // Compute bip34-based activation version summaries.
-    const auto count_2 = std::count_if(history.begin(), history.end(), ge_2);
-    const auto count_3 = std::count_if(history.begin(), history.end(), ge_3);
-    const auto count_4 = std::count_if(history.begin(), history.end(), ge_4);
+    // The bip34-based activation version summaries are promoted with data.
+    const auto count_2 = counts.bip34_versions;
+    const auto count_3 = counts.bip66_versions;
+    const auto count_4 = counts.bip65_versions;
 
     // Frozen activations (require version and enforce above freeze height).
     const auto bip34_ice = bip34(height, frozen, mainnet, testnet);
@@ -376,15 +376,15 @@ size_t chain_state::bip9_bit1_height(size_t height, uint32_t forks)
 
 uint32_t chain_state::median_time_past(const data& values, uint32_t)
 {
-    // Create a copy for the in-place sort.
-    auto times = values.timestamp.ordered;
-
-    // Sort the times by value to obtain the median.
-    std::sort(times.begin(), times.end());
+    return median_time_past(to_tally(values));
+}
 
+uint32_t chain_state::median_time_past(const tally& counts)
+{
     // Consensus defines median time using modulo 2 element selection.
     // This differs from arithmetic median which averages two middle values.
-    return times.empty() ? 0 : times[times.size() / 2];
+    return counts.timestamps == 0 ? 0 :
+        counts.sorted[counts.timestamps / 2];
 }
 
 // work_required
@@ -562,163 +562,199 @@ uint32_t chain_state::signal_version(uint32_t forks)
     return first_version;
 }
 
-// This is promotion from a preceding height to the next.
-chain_state::data chain_state::to_pool(const chain_state& top)
+// Summarize the ordered values of the given data (full scan).
+chain_state::tally chain_state::to_tally(const data& values)
 {
-    // Alias configured forks.
-    const auto forks = top.forks_;
+    const auto& history = values.version.ordered;
+    const auto& times = values.timestamp.ordered;
+
+    const auto ge = [](size_t version)
+    {
+        return [=](uint32_t value)
+        {
+            return is_version_at_least(value, version);
+        };
+    };
 
+    tally counts;
+    counts.bip34_versions = std::count_if(history.begin(), history.end(),
+        ge(bip34_version));
+    counts.bip66_versions = std::count_if(history.begin(), history.end(),
+        ge(bip66_version));
+    counts.bip65_versions = std::count_if(history.begin(), history.end(),
+        ge(bip65_version));
+
+    // Only the highest timestamps contribute to the median.
+    counts.timestamps = std::min(times.size(), median_time_past_interval);
+    const auto first = times.end() - counts.timestamps;
+    std::copy(first, times.end(), counts.sorted.begin());
+    std::sort(counts.sorted.begin(), counts.sorted.begin() + counts.timestamps);
+    return counts;
+}
+
+// This is promotion from a preceding height to the next.
+void chain_state::promote(data& values, tally& counts, uint32_t forks)
+{
     // Retargeting is only activated via configuration.
     const auto retarget = script::is_enabled(forks, rule_fork::retarget);
 
-    // Copy data from presumed previous-height block state.
-    auto data = top.data_;
-
     // If this overflows height is zero and result is handled as invalid.
-    const auto height = data.height + 1u;
+    const auto height = values.height + 1u;
+
+    auto& bits = values.bits.ordered;
+    auto& versions = values.version.ordered;
+    auto& times = values.timestamp.ordered;
+
+    const auto add = [](tally& counts, uint32_t version)
+    {
+        counts.bip34_versions += is_version_at_least(version, bip34_version);
+        counts.bip66_versions += is_version_at_least(version, bip66_version);
+        counts.bip65_versions += is_version_at_least(version, bip65_version);
+    };
+
+    const auto remove = [](tally& counts, uint32_t version)
+    {
+        counts.bip34_versions -= is_version_at_least(version, bip34_version);
+        counts.bip66_versions -= is_version_at_least(version, bip66_version);
+        counts.bip65_versions -= is_version_at_least(version, bip65_version);
+    };
+
+    // The timestamp that leaves the median window, if the window is full.
+    const auto full = times.size() >= median_time_past_interval;
+    const auto leaving = full ? *(times.end() - median_time_past_interval) : 0;
 
     // Enqueue previous block values to collections.
-    data.bits.ordered.push_back(data.bits.self);
-    data.version.ordered.push_back(data.version.self);
-    data.timestamp.ordered.push_back(data.timestamp.self);
+    bits.push_back(values.bits.self);
+    versions.push_back(values.version.self);
+    times.push_back(values.timestamp.self);
+    add(counts, values.version.self);
 
     // If bits collection overflows, dequeue oldest member.
-    if (data.bits.ordered.size() > bits_count(height, forks))
-        data.bits.ordered.pop_front();
+    if (bits.size() > bits_count(height, forks))
+        bits.pop_front();
 
     // If version collection overflows, dequeue oldest member.
-    if (data.version.ordered.size() > version_count(height, forks))
-        data.version.ordered.pop_front();
+    if (versions.size() > version_count(height, forks))
+    {
+        remove(counts, versions.front());
+        versions.pop_front();
+    }
 
     // If timestamp collection overflows, dequeue oldest member.
-    if (data.timestamp.ordered.size() > timestamp_count(height, forks))
-        data.timestamp.ordered.pop_front();
+    if (times.size() > timestamp_count(height, forks))
+        times.pop_front();
+
+    // Slide a full median window by replacing the value that left it,
+    // otherwise (below the interval height) the window is simply resorted.
+    if (full)
+    {
+        const auto begin = counts.sorted.begin();
+        const auto end = begin + counts.timestamps;
+        const auto self = values.timestamp.self;
+
+        auto it = std::lower_bound(begin, end, leaving);
+        BITCOIN_ASSERT_MSG(it != end && *it == leaving, "invalid tally");
+        std::copy(it + 1, end, it);
+
+        it = std::upper_bound(begin, end - 1, self);
+        std::copy_backward(it, end - 1, end);
+        *it = self;
+    }
+    else
+    {
+        counts.timestamps = times.size();
+        std::copy(times.begin(), times.end(), counts.sorted.begin());
+        std::sort(counts.sorted.begin(), counts.sorted.begin() +
+            counts.timestamps);
+    }
 
     // Regtest does not perform retargeting.
     // If promoting from retarget height, move that timestamp into retarget.
     if (retarget && is_retarget_height(height - 1u))
-        data.timestamp.retarget = data.timestamp.self;
+        values.timestamp.retarget = values.timestamp.self;
 
     // Replace previous block state with tx pool chain state for next height.
     // Only height and version used by tx pool, others promotable or unused.
-    // Preserve data.allow_collisions_hash promotion.
-    // Preserve data.bip9_bit0_hash promotion.
-    // Preserve data.bip9_bit1_hash promotion.
-    data.height = height;
-    data.hash = null_hash;
-    data.bits.self = work_limit(retarget);
-    data.version.self = signal_version(forks);
-    data.timestamp.self = max_uint32;
-    return data;
-}
-
-// Constructor (top to pool).
-// This generates a state for the pool above the presumed top block state.
-chain_state::chain_state(const chain_state& top)
-  : data_(to_pool(top)),
-    forks_(top.forks_),
-    checkpoints_(top.checkpoints_),
-    active_(activation(data_, forks_)),
-    work_required_(work_required(data_, forks_)),
-    median_time_past_(median_time_past(data_, forks_))
-{
+    // Preserve values.allow_collisions_hash promotion.
+    // Preserve values.bip9_bit0_hash promotion.
+    // Preserve values.bip9_bit1_hash promotion.
+    values.height = height;
+    values.hash = null_hash;
+    values.bits.self = work_limit(retarget);
+    values.version.self = signal_version(forks);
+    values.timestamp.self = max_uint32;
 }
 
-chain_state::data chain_state::to_block(const chain_state& pool,
-    const block& block)
+// This replaces the pool (empty) block state with the given header state.
+void chain_state::populate(data& values, const header& header, uint32_t forks)
 {
-    // Alias configured forks.
-    const auto forks = pool.forks_;
-
     // Retargeting and testnet are only activated via configuration.
     const auto testnet = script::is_enabled(forks, rule_fork::easy_blocks);
     const auto retarget = script::is_enabled(forks, rule_fork::retarget);
     const auto mainnet = retarget && !testnet;
 
-    // Copy data from presumed same-height pool state.
-    auto data = pool.data_;
-
-    // Replace pool chain state with block state at same (next) height.
-    // Preserve data.timestamp.retarget promotion.
-    const auto& header = block.header();
-    data.hash = header.hash();
-    data.bits.self = header.bits();
-    data.version.self = header.version();
-    data.timestamp.self = header.timestamp();
+    // Preserve values.timestamp.retarget promotion.
+    values.hash = header.hash();
+    values.bits.self = header.bits();
+    values.version.self = header.version();
+    values.timestamp.self = header.timestamp();
 
     // Cache hash of bip34 height block, otherwise use preceding state.
-    if (allow_collisions(data.height, mainnet, testnet))
-        data.allow_collisions_hash = data.hash;
+    if (allow_collisions(values.height, mainnet, testnet))
+        values.allow_collisions_hash = values.hash;
 
     // Cache hash of bip9 bit0 height block, otherwise use preceding state.
-    if (bip9_bit0_active(data.height, mainnet, testnet))
-        data.bip9_bit0_hash = data.hash;
+    if (bip9_bit0_active(values.height, mainnet, testnet))
+        values.bip9_bit0_hash = values.hash;
 
     // Cache hash of bip9 bit1 height block, otherwise use preceding state.
-    if (bip9_bit1_active(data.height, mainnet, testnet))
-        data.bip9_bit1_hash = data.hash;
+    if (bip9_bit1_active(values.height, mainnet, testnet))
+        values.bip9_bit1_hash = values.hash;
+}
 
-    return data;
+// Compute the properties of the current data from it and its tally.
+void chain_state::compute()
+{
+    active_ = activation(data_, tally_, forks_);
+    work_required_ = work_required(data_, forks_);
+    median_time_past_ = median_time_past(tally_);
+}
+
+// Constructor (top to pool).
+// This generates a state for the pool above the presumed top block state.
+chain_state::chain_state(const chain_state& top)
+  : data_(top.data_),
+    forks_(top.forks_),
+    checkpoints_(top.checkpoints_),
+    tally_(top.tally_)
+{
+    promote(data_, tally_, forks_);
+    compute();
 }
 
 // Constructor (tx pool to block).
 // This assumes that the pool state is the same height as the block.
 chain_state::chain_state(const chain_state& pool, const block& block)
-  : data_(to_block(pool, block)),
+  : data_(pool.data_),
     forks_(pool.forks_),
     checkpoints_(pool.checkpoints_),
-    active_(activation(data_, forks_)),
-    work_required_(work_required(data_, forks_)),
-    median_time_past_(median_time_past(data_, forks_))
+    tally_(pool.tally_)
 {
-}
-
-chain_state::data chain_state::to_header(const chain_state& parent,
-    const header& header)
-{
-    // Alias configured forks.
-    const auto forks = parent.forks_;
-
-    // Retargeting and testnet are only activated via configuration.
-    const auto testnet = script::is_enabled(forks, rule_fork::easy_blocks);
-    const auto retarget = script::is_enabled(forks, rule_fork::retarget);
-    const auto mainnet = retarget && !testnet;
-
-    // Copy and promote data from presumed parent-height header/block state.
-    auto data = to_pool(parent);
-
-    // Replace the pool (empty) current block state with given header state.
-    // Preserve data.timestamp.retarget promotion.
-    data.hash = header.hash();
-    data.bits.self = header.bits();
-    data.version.self = header.version();
-    data.timestamp.self = header.timestamp();
-
-    // Cache hash of bip34 height block, otherwise use preceding state.
-    if (allow_collisions(data.height, mainnet, testnet))
-        data.allow_collisions_hash = data.hash;
-
-    // Cache hash of bip9 bit0 height block, otherwise use preceding state.
-    if (bip9_bit0_active(data.height, mainnet, testnet))
-        data.bip9_bit0_hash = data.hash;
-
-    // Cache hash of bip9 bit1 height block, otherwise use preceding state.
-    if (bip9_bit1_active(data.height, mainnet, testnet))
-        data.bip9_bit1_hash = data.hash;
-
-    return data;
+    populate(data_, block.header(), forks_);
+    compute();
 }
 
 // Constructor (parent to header).
 // This assumes that parent is the state of the header's previous block.
 chain_state::chain_state(const chain_state& parent, const header& header)
-  : data_(to_header(parent, header)),
+  : data_(parent.data_),
     forks_(parent.forks_),
     checkpoints_(parent.checkpoints_),
-    active_(activation(data_, forks_)),
-    work_required_(work_required(data_, forks_)),
-    median_time_past_(median_time_past(data_, forks_))
+    tally_(parent.tally_)
 {
+    promote(data_, tally_, forks_);
+    populate(data_, header, forks_);
+    compute();
 }
 
 // Constructor (from raw data).
@@ -729,10 +765,19 @@ chain_state::chain_state(data&& values, const checkpoints& checkpoints,
   : data_(std::move(values)),
     forks_(forks | rule_fork::allow_collisions),
     checkpoints_(checkpoints),
-    active_(activation(data_, forks_)),
-    work_required_(work_required(data_, forks_)),
-    median_time_past_(median_time_past(data_, forks_))
+    tally_(to_tally(data_))
+{
+    compute();
+}
+
+// Advance (parent to header, in place).
+// This is equivalent to replacing this state with chain_state(*this, header)
+// but reuses the collections of this state instead of copying them.
+void chain_state::advance(const header& header)
 {
+    promote(data_, tally_, forks_);
+    populate(data_, header, forks_);
+    compute();
 }
 
 // Semantic invalidity can also arise from too many/few values in the arrays.
@@ -20,23 +20,34 @@
 
 #include <chrono>
 #include <cstddef>
+#include <memory>
 #include <utility>
+#include <vector>
 #include <bitcoin/bitcoin/chain/chain_state.hpp>
 #include <bitcoin/bitcoin/chain/compact.hpp>
 #include <bitcoin/bitcoin/constants.hpp>
 #include <bitcoin/bitcoin/error.hpp>
+#include <bitcoin/bitcoin/machine/rule_fork.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
 #include <bitcoin/bitcoin/utility/container_source.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+#include <bitcoin/bitcoin/utility/sha256_writer.hpp>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
 
 namespace libbitcoin {
 namespace chain {
 
+using namespace bc::machine;
+
 // Use system clock because we require accurate time of day.
 using wall_clock = std::chrono::system_clock;
 
+// The number of headers claimed by a thread for each parallel check batch.
+static constexpr size_t validate_batch_size = 64;
+
 // Constructors.
 //-----------------------------------------------------------------------------
 
@@ -46,7 +57,7 @@ header::header()
 }
 
 header::header(header&& other)
-  : hash_(other.hash_cache()),
+  : hash_(other.hash_),
     version_(other.version_),
     previous_block_hash_(std::move(other.previous_block_hash_)),
     merkle_(std::move(other.merkle_)),
@@ -58,7 +69,7 @@ header::header(header&& other)
 }
 
 header::header(const header& other)
-  : hash_(other.hash_cache()),
+  : hash_(other.hash_),
     version_(other.version_),
     previous_block_hash_(other.previous_block_hash_),
     merkle_(other.merkle_),
@@ -94,19 +105,12 @@ header::header(uint32_t version, const hash_digest& previous_block_hash,
 {
 }
 
-// Private cache access for copy/move construction.
-header::hash_ptr header::hash_cache() const
-{
-    shared_lock lock(mutex_);
-    return hash_;
-}
-
 // Operators.
 //-----------------------------------------------------------------------------
 
 header& header::operator=(header&& other)
 {
-    hash_ = other.hash_cache();
+    hash_ = other.hash_;
     version_ = other.version_;
     previous_block_hash_ = std::move(other.previous_block_hash_);
     merkle_ = std::move(other.merkle_);
@@ -119,7 +123,7 @@ header& header::operator=(header&& other)
 
 header& header::operator=(const header& other)
 {
-    hash_ = other.hash_cache();
+    hash_ = other.hash_;
     version_ = other.version_;
     previous_block_hash_ = other.previous_block_hash_;
     merkle_ = other.merkle_;
@@ -190,8 +194,9 @@ header header::factory(reader& source, const hash_digest& hash, bool wire)
 
 bool header::from_data(const data_chunk& data, bool wire)
 {
-    data_source istream(data);
-    return from_data(istream, wire);
+    const auto begin = data.data();
+    auto source = make_safe_deserializer(begin, begin + data.size());
+    return from_data(source, wire);
 }
 
 bool header::from_data(std::istream& stream, bool wire)
@@ -200,7 +205,9 @@ bool header::from_data(std::istream& stream, bool wire)
     return from_data(source, wire);
 }
 
-bool header::from_data(reader& source, bool wire)
+// private
+template <class Source>
+bool header::deserialize(Source& source, bool wire)
 {
     ////reset();
 
@@ -220,15 +227,25 @@ bool header::from_data(reader& source, bool wire)
     return source;
 }
 
+bool header::from_data(reader& source, bool wire)
+{
+    return deserialize(source, wire);
+}
+
+bool header::from_data(byte_deserializer& source, bool wire)
+{
+    return deserialize(source, wire);
+}
+
 bool header::from_data(reader& source, hash_digest&& hash, bool wire)
 {
-    hash_ = std::make_shared<hash_digest>(std::move(hash));
+    hash_.set(std::move(hash));
     return from_data(source, wire);
 }
 
 bool header::from_data(reader& source, const hash_digest& hash, bool wire)
 {
-    hash_ = std::make_shared<hash_digest>(hash);
+    hash_.set(hash);
     return from_data(source, wire);
 }
 
@@ -259,13 +276,9 @@ bool header::is_valid() const
 
 data_chunk header::to_data(bool wire) const
 {
-    data_chunk data;
-    const auto size = serialized_size(wire);
-    data.reserve(size);
-    data_sink ostream(data);
-    to_data(ostream, wire);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
+    data_chunk data(serialized_size(wire));
+    auto sink = make_unsafe_serializer(data.data());
+    to_data(sink, wire);
     return data;
 }
 
@@ -275,7 +288,9 @@ void header::to_data(std::ostream& stream, bool wire) const
     to_data(sink, wire);
 }
 
-void header::to_data(writer& sink, bool wire) const
+// private
+template <class Sink>
+void header::serialize(Sink& sink, bool wire) const
 {
     sink.write_4_bytes_little_endian(version_);
     sink.write_hash(previous_block_hash_);
@@ -288,6 +303,16 @@ void header::to_data(writer& sink, bool wire) const
         sink.write_4_bytes_little_endian(validation.median_time_past);
 }
 
+void header::to_data(writer& sink, bool wire) const
+{
+    serialize(sink, wire);
+}
+
+void header::to_data(byte_serializer& sink, bool wire) const
+{
+    serialize(sink, wire);
+}
+
 // Size.
 //-----------------------------------------------------------------------------
 
@@ -394,43 +419,17 @@ void header::set_nonce(uint32_t value)
 // protected
 void header::invalidate_cache() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (hash_)
-    {
-        mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_.reset();
-        //---------------------------------------------------------------------
-        mutex_.unlock_and_lock_upgrade();
-    }
-
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    hash_.reset();
 }
 
 hash_digest header::hash() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (!hash_)
+    return hash_.get([this]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        mutex_.unlock_upgrade_and_lock();
-        hash_ = std::make_shared<hash_digest>(bitcoin_hash(to_data()));
-        mutex_.unlock_and_lock_upgrade();
-        //---------------------------------------------------------------------
-    }
-
-    const auto hash = *hash_;
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
+        sha256_writer sink;
+        to_data(sink);
+        return sink.bitcoin_hash();
+    });
 }
 
 // Validation helpers.
@@ -450,7 +449,9 @@ bool header::is_valid_timestamp() const
 bool header::is_valid_proof_of_work(bool retarget) const
 {
     const auto bits = compact(bits_);
-    static const uint256_t pow_limit(compact{ work_limit(retarget) });
+    static const uint256_t retarget_limit(compact{ work_limit(true) });
+    static const uint256_t no_retarget_limit(compact{ work_limit(false) });
+    const auto& pow_limit = retarget ? retarget_limit : no_retarget_limit;
 
     if (bits.is_overflowed())
         return false;
@@ -507,5 +508,84 @@ code header::accept(const chain_state& state) const
         return error::success;
 }
 
+chain_state::ptr header::validate(const list& headers,
+    const chain_state& parent, threadpool& pool, std::vector<code>& results)
+{
+    const auto count = headers.size();
+    results.assign(count, error::success);
+
+    if (headers.empty())
+        return nullptr;
+
+    // Retargeting is only activated via configuration (not height).
+    const auto retarget = parent.is_enabled(rule_fork::retarget);
+
+    // Check proof of work concurrently, which also caches each header hash.
+    const auto check = [&](size_t index)
+    {
+        results[index] = headers[index].check(retarget);
+        return true;
+    };
+
+    parallel_for(pool, count, validate_batch_size, check);
+
+    // The parent hash is null for a pool state, in which case it is not linked.
+    const auto& parent_hash = parent.data_.hash;
+    const auto linked = [&](size_t index)
+    {
+        const auto& previous = headers[index].previous_block_hash();
+        return index == 0 ? parent_hash == null_hash ||
+            previous == parent_hash : previous == headers[index - 1].hash();
+    };
+
+    chain_state::ptr state;
+    size_t index = 0;
+
+    // Accept in order, advancing a single state instead of copying per header.
+    for (; index < count; ++index)
+    {
+        auto& ec = results[index];
+
+        if (ec)
+            break;
+
+        if (!linked(index))
+        {
+            ec = error::invalid_previous_block;
+            break;
+        }
+
+        if (state)
+            state->advance(headers[index]);
+        else
+            state = std::make_shared<chain_state>(parent, headers[index]);
+
+        if ((ec = headers[index].accept(*state)))
+            break;
+    }
+
+    if (index == count)
+        return state;
+
+    // Headers above the first failure do not connect to a valid chain.
+    for (auto orphan = index + 1u; orphan < count; ++orphan)
+        results[orphan] = error::orphan_block;
+
+    // A state was advanced past the last valid header only if it was accepted
+    // against, so it is replayed to the last valid header (failure is rare).
+    if (index == 0)
+        return nullptr;
+
+    if (state->height() == parent.height() + index)
+        return state;
+
+    state = std::make_shared<chain_state>(parent, headers.front());
+
+    for (size_t valid = 1; valid < index; ++valid)
+        state->advance(headers[valid]);
+
+    return state;
+}
+
 } // namespace chain
 } // namespace libbitcoin
@@ -46,7 +46,7 @@ input::input()
 }
 
 input::input(input&& other)
-  : addresses_(other.addresses_cache()),
+  : addresses_(other.addresses_),
     previous_output_(std::move(other.previous_output_)),
     script_(std::move(other.script_)),
     witness_(std::move(other.witness_)),
@@ -55,7 +55,7 @@ input::input(input&& other)
 }
 
 input::input(const input& other)
-  : addresses_(other.addresses_cache()),
+  : addresses_(other.addresses_),
     previous_output_(other.previous_output_),
     script_(std::move(other.script_)),
     witness_(other.witness_),
@@ -79,13 +79,6 @@ input::input(const output_point& previous_output, const chain::script& script,
 {
 }
 
-// Private cache access for copy/move construction.
-input::addresses_ptr input::addresses_cache() const
-{
-    shared_lock lock(mutex_);
-    return addresses_;
-}
-
 input::input(output_point&& previous_output, chain::script&& script,
     chain::witness&& witness, uint32_t sequence)
   : previous_output_(std::move(previous_output)), script_(std::move(script)),
@@ -105,7 +98,7 @@ input::input(const output_point& previous_output, const chain::script& script,
 
 input& input::operator=(input&& other)
 {
-    addresses_ = other.addresses_cache();
+    addresses_ = other.addresses_;
     previous_output_ = std::move(other.previous_output_);
     script_ = std::move(other.script_);
     witness_ = std::move(other.witness_);
@@ -115,7 +108,7 @@ input& input::operator=(input&& other)
 
 input& input::operator=(const input& other)
 {
-    addresses_ = other.addresses_cache();
+    addresses_ = other.addresses_;
     previous_output_ = other.previous_output_;
     script_ = other.script_;
     witness_ = other.witness_;
@@ -162,8 +155,9 @@ input input::factory(reader& source, bool wire, bool witness)
 
 bool input::from_data(const data_chunk& data, bool wire, bool witness)
 {
-    data_source istream(data);
-    return from_data(istream, wire, witness);
+    const auto begin = data.data();
+    auto source = make_safe_deserializer(begin, begin + data.size());
+    return from_data(source, wire, witness);
 }
 
 bool input::from_data(std::istream& stream, bool wire, bool witness)
@@ -172,7 +166,9 @@ bool input::from_data(std::istream& stream, bool wire, bool witness)
     return from_data(source, wire, witness);
 }
 
-bool input::from_data(reader& source, bool wire, bool witness)
+// private
+template <class Source>
+bool input::deserialize(Source& source, bool wire, bool witness)
 {
     // Always write witness to store so that we know how to read it.
     witness |= !wire;
@@ -196,6 +192,16 @@ bool input::from_data(reader& source, bool wire, bool witness)
     return source;
 }
 
+bool input::from_data(reader& source, bool wire, bool witness)
+{
+    return deserialize(source, wire, witness);
+}
+
+bool input::from_data(byte_deserializer& source, bool wire, bool witness)
+{
+    return deserialize(source, wire, witness);
+}
+
 void input::reset()
 {
     previous_output_.reset();
@@ -216,13 +222,10 @@ bool input::is_valid() const
 
 data_chunk input::to_data(bool wire, bool witness) const
 {
-    data_chunk data;
-    const auto size = serialized_size(wire, witness);
-    data.reserve(size);
-    data_sink ostream(data);
-    to_data(ostream, wire, witness);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
+    // The wire witness is not written by input, so it is not sized here.
+    data_chunk data(serialized_size(wire, witness && !wire));
+    auto sink = make_unsafe_serializer(data.data());
+    to_data(sink, wire, witness);
     return data;
 }
 
@@ -232,7 +235,9 @@ void input::to_data(std::ostream& stream, bool wire, bool witness) const
     to_data(sink, wire, witness);
 }
 
-void input::to_data(writer& sink, bool wire, bool witness) const
+// private
+template <class Sink>
+void input::serialize(Sink& sink, bool wire, bool witness) const
 {
     // Always write witness to store so that we know how to read it.
     witness |= !wire;
@@ -247,6 +252,16 @@ void input::to_data(writer& sink, bool wire, bool witness) const
     sink.write_4_bytes_little_endian(sequence_);
 }
 
+void input::to_data(writer& sink, bool wire, bool witness) const
+{
+    serialize(sink, wire, witness);
+}
+
+void input::to_data(byte_serializer& sink, bool wire, bool witness) const
+{
+    serialize(sink, wire, witness);
+}
+
 // Size.
 //-----------------------------------------------------------------------------
 
@@ -338,21 +353,7 @@ void input::set_sequence(uint32_t value)
 // protected
 void input::invalidate_cache() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (addresses_)
-    {
-        mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        addresses_.reset();
-        //---------------------------------------------------------------------
-        mutex_.unlock_and_lock_upgrade();
-    }
-
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    addresses_.reset();
 }
 
 payment_address input::address() const
@@ -363,27 +364,11 @@ payment_address input::address() const
 
 payment_address::list input::addresses() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (!addresses_)
+    return addresses_.get([this]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        mutex_.unlock_upgrade_and_lock();
-
         // TODO: expand to include segregated witness address extraction.
-        addresses_ = std::make_shared<payment_address::list>(
-            payment_address::extract_input(script_));
-        mutex_.unlock_and_lock_upgrade();
-        //---------------------------------------------------------------------
-    }
-
-    const auto addresses = *addresses_;
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return addresses;
+        return payment_address::extract_input(script_);
+    });
 }
 
 // Utilities.
@@ -50,7 +50,7 @@ output::output()
 }
 
 output::output(output&& other)
-  : addresses_(other.addresses_cache()),
+  : addresses_(other.addresses_),
     value_(other.value_),
     script_(std::move(other.script_)),
     validation(other.validation)
@@ -58,7 +58,7 @@ output::output(output&& other)
 }
 
 output::output(const output& other)
-  : addresses_(other.addresses_cache()),
+  : addresses_(other.addresses_),
     value_(other.value_),
     script_(other.script_),
     validation(other.validation)
@@ -79,19 +79,12 @@ output::output(uint64_t value, const chain::script& script)
 {
 }
 
-// Private cache access for copy/move construction.
-output::addresses_ptr output::addresses_cache() const
-{
-    shared_lock lock(mutex_);
-    return addresses_;
-}
-
 // Operators.
 //-----------------------------------------------------------------------------
 
 output& output::operator=(output&& other)
 {
-    addresses_ = other.addresses_cache();
+    addresses_ = other.addresses_;
     value_ = other.value_;
     script_ = std::move(other.script_);
     validation = std::move(other.validation);
@@ -100,7 +93,7 @@ output& output::operator=(output&& other)
 
 output& output::operator=(const output& other)
 {
-    addresses_ = other.addresses_cache();
+    addresses_ = other.addresses_;
     value_ = other.value_;
     script_ = other.script_;
     validation = other.validation;
@@ -143,8 +136,9 @@ output output::factory(reader& source, bool wire)
 
 bool output::from_data(const data_chunk& data, bool wire)
 {
-    data_source istream(data);
-    return from_data(istream, wire);
+    const auto begin = data.data();
+    auto source = make_safe_deserializer(begin, begin + data.size());
+    return from_data(source, wire);
 }
 
 bool output::from_data(std::istream& stream, bool wire)
@@ -153,7 +147,9 @@ bool output::from_data(std::istream& stream, bool wire)
     return from_data(source, wire);
 }
 
-bool output::from_data(reader& source, bool wire, bool)
+// private
+template <class Source>
+bool output::deserialize(Source& source, bool wire)
 {
     reset();
 
@@ -169,6 +165,16 @@ bool output::from_data(reader& source, bool wire, bool)
     return source;
 }
 
+bool output::from_data(reader& source, bool wire, bool)
+{
+    return deserialize(source, wire);
+}
+
+bool output::from_data(byte_deserializer& source, bool wire, bool)
+{
+    return deserialize(source, wire);
+}
+
 // protected
 void output::reset()
 {
@@ -187,13 +193,9 @@ bool output::is_valid() const
 
 data_chunk output::to_data(bool wire) const
 {
-    data_chunk data;
-    const auto size = serialized_size(wire);
-    data.reserve(size);
-    data_sink ostream(data);
-    to_data(ostream, wire);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
+    data_chunk data(serialized_size(wire));
+    auto sink = make_unsafe_serializer(data.data());
+    to_data(sink, wire);
     return data;
 }
 
@@ -203,7 +205,9 @@ void output::to_data(std::ostream& stream, bool wire) const
     to_data(sink, wire);
 }
 
-void output::to_data(writer& sink, bool wire, bool) const
+// private
+template <class Sink>
+void output::serialize(Sink& sink, bool wire) const
 {
     if (!wire)
     {
@@ -215,6 +219,16 @@ void output::to_data(writer& sink, bool wire, bool) const
     script_.to_data(sink, true);
 }
 
+void output::to_data(writer& sink, bool wire, bool) const
+{
+    serialize(sink, wire);
+}
+
+void output::to_data(byte_serializer& sink, bool wire, bool) const
+{
+    serialize(sink, wire);
+}
+
 // Size.
 //-----------------------------------------------------------------------------
 
@@ -258,21 +272,7 @@ void output::set_script(chain::script&& value)
 // protected
 void output::invalidate_cache() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (addresses_)
-    {
-        mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        addresses_.reset();
-        //---------------------------------------------------------------------
-        mutex_.unlock_and_lock_upgrade();
-    }
-
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    addresses_.reset();
 }
 
 payment_address output::address(uint8_t p2kh_version,
@@ -285,26 +285,11 @@ payment_address output::address(uint8_t p2kh_version,
 payment_address::list output::addresses(uint8_t p2kh_version,
     uint8_t p2sh_version) const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (!addresses_)
+    return addresses_.get([this, p2kh_version, p2sh_version]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        mutex_.unlock_upgrade_and_lock();
-        addresses_ = std::make_shared<payment_address::list>(
-            payment_address::extract_output(script_, p2kh_version,
-                p2sh_version));
-        mutex_.unlock_and_lock_upgrade();
-        //---------------------------------------------------------------------
-    }
-
-    const auto addresses = *addresses_;
-    mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return addresses;
+        return payment_address::extract_output(script_, p2kh_version,
+            p2sh_version);
+    });
 }
 
 // Validation helpers.
@@ -142,8 +142,9 @@ point point::factory(reader& source, bool wire)
 
 bool point::from_data(const data_chunk& data, bool wire)
 {
-    data_source istream(data);
-    return from_data(istream, wire);
+    const auto begin = data.data();
+    auto source = make_safe_deserializer(begin, begin + data.size());
+    return from_data(source, wire);
 }
 
 bool point::from_data(std::istream& stream, bool wire)
@@ -152,7 +153,9 @@ bool point::from_data(std::istream& stream, bool wire)
     return from_data(source, wire);
 }
 
-bool point::from_data(reader& source, bool wire)
+// private
+template <class Source>
+bool point::deserialize(Source& source, bool wire)
 {
     reset();
 
@@ -177,6 +180,16 @@ bool point::from_data(reader& source, bool wire)
     return source;
 }
 
+bool point::from_data(reader& source, bool wire)
+{
+    return deserialize(source, wire);
+}
+
+bool point::from_data(byte_deserializer& source, bool wire)
+{
+    return deserialize(source, wire);
+}
+
 // protected
 void point::reset()
 {
@@ -195,13 +208,9 @@ bool point::is_valid() const
 
 data_chunk point::to_data(bool wire) const
 {
-    data_chunk data;
-    const auto size = serialized_size(wire);
-    data.reserve(size);
-    data_sink ostream(data);
-    to_data(ostream, wire);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
+    data_chunk data(serialized_size(wire));
+    auto sink = make_unsafe_serializer(data.data());
+    to_data(sink, wire);
     return data;
 }
 
@@ -211,7 +220,9 @@ void point::to_data(std::ostream& stream, bool wire) const
     to_data(sink, wire);
 }
 
-void point::to_data(writer& sink, bool wire) const
+// private
+template <class Sink>
+void point::serialize(Sink& sink, bool wire) const
 {
     sink.write_hash(hash_);
 
@@ -226,6 +237,16 @@ void point::to_data(writer& sink, bool wire) const
     }
 }
 
+void point::to_data(writer& sink, bool wire) const
+{
+    serialize(sink, wire);
+}
+
+void point::to_data(byte_serializer& sink, bool wire) const
+{
+    serialize(sink, wire);
+}
+
 // Iterator.
 //-----------------------------------------------------------------------------
 
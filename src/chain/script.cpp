@@ -34,6 +34,7 @@
 #include <bitcoin/bitcoin/formats/base_16.hpp>
 #include <bitcoin/bitcoin/math/elliptic_curve.hpp>
 #include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/machine/decoded_script.hpp>
 #include <bitcoin/bitcoin/machine/interpreter.hpp>
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
@@ -49,6 +50,7 @@
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/sha256_writer.hpp>
 #include <bitcoin/bitcoin/utility/string.hpp>
 
 namespace libbitcoin {
@@ -66,22 +68,19 @@ static const auto one_hash = hash_literal(
 
 // A default instance is invalid (until modified).
 script::script()
-  : cached_(false),
-    valid_(false)
+  : valid_(false)
 {
 }
 
 script::script(script&& other)
-  : operations_(std::move(other.operations_move())),
-    cached_(!operations_.empty()),
+  : operations_(std::move(other.operations_)),
     bytes_(std::move(other.bytes_)),
     valid_(other.valid_)
 {
 }
 
 script::script(const script& other)
-  : operations_(other.operations_copy()),
-    cached_(!operations_.empty()),
+  : operations_(other.operations_),
     bytes_(other.bytes_),
     valid_(other.valid_)
 {
@@ -107,7 +106,6 @@ script::script(data_chunk&& encoded, bool prefix)
 
     // This is an optimization that avoids streaming the encoded bytes.
     bytes_ = std::move(encoded);
-    cached_ = false;
     valid_ = true;
 }
 
@@ -116,28 +114,13 @@ script::script(const data_chunk& encoded, bool prefix)
     valid_ = from_data(encoded, prefix);
 }
 
-// Private cache access for move construction.
-script::operation::list& script::operations_move()
-{
-    shared_lock lock(mutex_);
-    return operations_;
-}
-
-// Private cache access for copy construction.
-const script::operation::list& script::operations_copy() const
-{
-    shared_lock lock(mutex_);
-    return operations_;
-}
-
 // Operators.
 //-----------------------------------------------------------------------------
 
 // Concurrent read/write is not supported, so no critical section.
 script& script::operator=(script&& other)
 {
-    operations_ = other.operations_move();
-    cached_ = !operations_.empty();
+    operations_ = std::move(other.operations_);
     bytes_ = std::move(other.bytes_);
     valid_ = other.valid_;
     return *this;
@@ -146,8 +129,7 @@ script& script::operator=(script&& other)
 // Concurrent read/write is not supported, so no critical section.
 script& script::operator=(const script& other)
 {
-    operations_ = other.operations_copy();
-    cached_ = !operations_.empty();
+    operations_ = other.operations_;
     bytes_ = other.bytes_;
     valid_ = other.valid_;
     return *this;
@@ -192,8 +174,9 @@ script script::factory(reader& source, bool prefix)
 
 bool script::from_data(const data_chunk& encoded, bool prefix)
 {
-    data_source istream(encoded);
-    return from_data(istream, prefix);
+    const auto begin = encoded.data();
+    auto source = make_safe_deserializer(begin, begin + encoded.size());
+    return from_data(source, prefix);
 }
 
 bool script::from_data(std::istream& stream, bool prefix)
@@ -203,7 +186,9 @@ bool script::from_data(std::istream& stream, bool prefix)
 }
 
 // Concurrent read/write is not supported, so no critical section.
-bool script::from_data(reader& source, bool prefix)
+// private
+template <class Source>
+bool script::deserialize(Source& source, bool prefix)
 {
     reset();
     valid_ = true;
@@ -230,6 +215,16 @@ bool script::from_data(reader& source, bool prefix)
     return source;
 }
 
+bool script::from_data(reader& source, bool prefix)
+{
+    return deserialize(source, prefix);
+}
+
+bool script::from_data(byte_deserializer& source, bool prefix)
+{
+    return deserialize(source, prefix);
+}
+
 // Concurrent read/write is not supported, so no critical section.
 bool script::from_string(const std::string& mnemonic)
 {
@@ -254,8 +249,7 @@ void script::from_operations(operation::list&& ops)
 {
     ////reset();
     bytes_ = operations_to_data(ops);
-    operations_ = std::move(ops);
-    cached_ = true;
+    operations_.set(std::move(ops));
     valid_ = true;
 }
 
@@ -264,8 +258,7 @@ void script::from_operations(const operation::list& ops)
 {
     ////reset();
     bytes_ = operations_to_data(ops);
-    operations_ = ops;
-    cached_ = true;
+    operations_.set(ops);
     valid_ = true;
 }
 
@@ -304,9 +297,7 @@ void script::reset()
     bytes_.clear();
     bytes_.shrink_to_fit();
     valid_ = false;
-    cached_ = false;
-    operations_.clear();
-    operations_.shrink_to_fit();
+    operations_.reset();
 }
 
 bool script::is_valid() const
@@ -320,7 +311,8 @@ bool script::is_valid_operations() const
 {
     // Script validity is independent of individual operation validity.
     // There is a trailing invalid/default op if a push op had a size mismatch.
-    return operations().empty() || operations_.back().is_valid();
+    const auto& ops = operations();
+    return ops.empty() || ops.back().is_valid();
 }
 
 // Serialization.
@@ -328,13 +320,9 @@ bool script::is_valid_operations() const
 
 data_chunk script::to_data(bool prefix) const
 {
-    data_chunk data;
-    const auto size = serialized_size(prefix);
-    data.reserve(size);
-    data_sink ostream(data);
-    to_data(ostream, prefix);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
+    data_chunk data(serialized_size(prefix));
+    auto sink = make_unsafe_serializer(data.data());
+    to_data(sink, prefix);
     return data;
 }
 
@@ -344,7 +332,9 @@ void script::to_data(std::ostream& stream, bool prefix) const
     to_data(sink, prefix);
 }
 
-void script::to_data(writer& sink, bool prefix) const
+// private
+template <class Sink>
+void script::serialize(Sink& sink, bool prefix) const
 {
     // TODO: optimize by always storing the prefixed serialization.
     if (prefix)
@@ -353,6 +343,16 @@ void script::to_data(writer& sink, bool prefix) const
     sink.write_bytes(bytes_);
 }
 
+void script::to_data(writer& sink, bool prefix) const
+{
+    serialize(sink, prefix);
+}
+
+void script::to_data(byte_serializer& sink, bool prefix) const
+{
+    serialize(sink, prefix);
+}
+
 std::string script::to_string(uint32_t active_forks) const
 {
     auto first = true;
@@ -432,66 +432,42 @@ size_t script::serialized_size(bool prefix) const
 // protected
 const operation::list& script::operations() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (cached_)
+    return operations_.get([this]()
     {
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return operations_;
-    }
-
-    operation op;
-    data_source istream(bytes_);
-    istream_reader source(istream);
-    const auto size = bytes_.size();
-
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    mutex_.unlock_upgrade_and_lock();
-
-    // One operation per byte is the upper limit of operations.
-    operations_.reserve(size);
-
-    // ************************************************************************
-    // CONSENSUS: In the case of a coinbase script we must parse the entire
-    // script, beyond just the BIP34 requirements, so that sigops can be
-    // calculated from the script. These are counted despite being irrelevant.
-    // In this case an invalid script is parsed to the extent possible.
-    // ************************************************************************
-
-    // If an op fails it is pushed to operations and the loop terminates.
-    // To validate the ops the caller must test the last op.is_valid(), or may
-    // text script.is_valid_operations(), which is done in script validation.
-    while (!source.is_exhausted())
-    {
-        op.from_data(source);
-        operations_.push_back(std::move(op));
-    }
-
-    operations_.shrink_to_fit();
-    cached_ = true;
-
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
+        operation op;
+        operation::list ops;
+        data_source istream(bytes_);
+        istream_reader source(istream);
+
+        // One operation per byte is the upper limit of operations.
+        ops.reserve(bytes_.size());
+
+        // ********************************************************************
+        // CONSENSUS: In the case of a coinbase script we must parse the entire
+        // script, beyond just the BIP34 requirements, so that sigops can be
+        // calculated from the script. These are counted despite being
+        // irrelevant. In this case an invalid script is parsed to the extent
+        // possible.
+        // ********************************************************************
+
+        // If an op fails it is pushed to operations and the loop terminates.
+        // To validate the ops the caller must test the last op.is_valid(), or
+        // may text script.is_valid_operations(), which is done in script
+        // validation.
+        while (!source.is_exhausted())
+        {
+            op.from_data(source);
+            ops.push_back(std::move(op));
+        }
 
-    return operations_;
+        ops.shrink_to_fit();
+        return ops;
+    });
 }
 
 // Signing (unversioned).
 //-----------------------------------------------------------------------------
 
-inline hash_digest signature_hash(const transaction& tx, uint32_t sighash_type)
-{
-    // There is no rational interpretation of a signature hash for a coinbase.
-    BITCOIN_ASSERT(!tx.is_coinbase());
-
-    auto serialized = tx.to_data(true, false);
-    extend_data(serialized, to_little_endian(sighash_type));
-    return bitcoin_hash(serialized);
-}
-
 //*****************************************************************************
 // CONSENSUS: Due to masking of bits 6/7 (8 is the anyone_can_pay flag),
 // there are 4 possible 7 bit values that can set "single" and 4 others that
@@ -515,120 +491,129 @@ inline uint8_t is_sighash_enum(uint8_t sighash_type, sighash_algorithm value)
     return to_sighash_enum(sighash_type) == value;
 }
 
-static hash_digest sign_none(const transaction& tx, uint32_t input_index,
-    const script& script_code, uint8_t sighash_type)
+//*****************************************************************************
+// CONSENSUS: code separators are excluded from the signed script code.
+//*****************************************************************************
+static void write_script_code(writer& sink, const script& script_code)
 {
-    input::list ins;
-    const auto& inputs = tx.inputs();
-    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
-
-    BITCOIN_ASSERT(input_index < inputs.size());
-    const auto& self = inputs[input_index];
-
-    if (any)
+    const auto sum = [](size_t total, const operation& op)
     {
-        // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
-    }
-    else
-    {
-        // Erase all input scripts and sequences.
-        for (const auto& input: inputs)
-            ins.emplace_back(input.previous_output(), script{}, 0);
+        return op.code() == opcode::codeseparator ? total :
+            total + op.serialized_size();
+    };
 
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ins[input_index].set_sequence(self.sequence());
-    }
+    const auto& ops = script_code.operations();
+    const auto size = std::accumulate(ops.begin(), ops.end(), size_t(0), sum);
+    sink.write_variable_little_endian(size);
 
-    // Move new inputs to new transaction and drop outputs.
-    return signature_hash({ tx.version(), tx.locktime(), std::move(ins), {} },
-        sighash_type);
+    for (const auto& op: ops)
+        if (op.code() != opcode::codeseparator)
+            op.to_data(sink);
 }
 
-static hash_digest sign_single(const transaction& tx, uint32_t input_index,
-    const script& script_code, uint8_t sighash_type)
+// Stream the inputs of the modified transaction (without copying it).
+// Other input scripts are empty and sequences are optionally cleared.
+static void write_inputs(writer& sink, const transaction& tx,
+    uint32_t input_index, const script& script_code, bool any,
+    bool sequences)
 {
-    input::list ins;
     const auto& inputs = tx.inputs();
-    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
-
     BITCOIN_ASSERT(input_index < inputs.size());
     const auto& self = inputs[input_index];
 
     if (any)
     {
         // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
+        sink.write_variable_little_endian(1);
+        self.previous_output().to_data(sink);
+        write_script_code(sink, script_code);
+        sink.write_4_bytes_little_endian(self.sequence());
+        return;
     }
-    else
+
+    sink.write_variable_little_endian(inputs.size());
+
+    for (size_t index = 0; index < inputs.size(); ++index)
     {
-        // Erase all input scripts and sequences.
-        for (const auto& input: inputs)
-            ins.emplace_back(input.previous_output(), script{}, 0);
+        const auto& input = inputs[index];
+        input.previous_output().to_data(sink);
 
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ins[input_index].set_sequence(self.sequence());
+        if (index == input_index)
+        {
+            write_script_code(sink, script_code);
+            sink.write_4_bytes_little_endian(self.sequence());
+        }
+        else
+        {
+            sink.write_variable_little_endian(0);
+            sink.write_4_bytes_little_endian(sequences ? input.sequence() : 0);
+        }
     }
+}
 
-    // Trim and clear outputs except that of specified input index.
-    const auto& outputs = tx.outputs();
-    output::list outs(input_index + 1);
+static hash_digest sign_none(const transaction& tx, uint32_t input_index,
+    const script& script_code, uint8_t sighash_type)
+{
+    sha256_writer sink;
+    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
 
-    BITCOIN_ASSERT(input_index < outputs.size());
-    outs.back() = outputs[input_index];
+    sink.write_4_bytes_little_endian(tx.version());
+    write_inputs(sink, tx, input_index, script_code, any, false);
 
-    // Move new inputs and new outputs to new transaction.
-    return signature_hash({ tx.version(), tx.locktime(), std::move(ins),
-        std::move(outs) }, sighash_type);
+    // Drop outputs.
+    sink.write_variable_little_endian(0);
+
+    sink.write_4_bytes_little_endian(tx.locktime());
+    sink.write_4_bytes_little_endian(sighash_type);
+    return sink.bitcoin_hash();
 }
 
-static hash_digest sign_all(const transaction& tx, uint32_t input_index,
+static hash_digest sign_single(const transaction& tx, uint32_t input_index,
     const script& script_code, uint8_t sighash_type)
 {
-    input::list ins;
-    const auto& inputs = tx.inputs();
+    sha256_writer sink;
     const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
 
-    BITCOIN_ASSERT(input_index < inputs.size());
-    const auto& self = inputs[input_index];
+    sink.write_4_bytes_little_endian(tx.version());
+    write_inputs(sink, tx, input_index, script_code, any, false);
 
-    if (any)
-    {
-        // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
-    }
-    else
+    const auto& outputs = tx.outputs();
+    BITCOIN_ASSERT(input_index < outputs.size());
+    sink.write_variable_little_endian(input_index + 1);
+
+    // Trim and clear outputs except that of specified input index.
+    for (size_t index = 0; index < input_index; ++index)
     {
-        // Erase all input scripts.
-        for (const auto& input: inputs)
-            ins.emplace_back(input.previous_output(), script{},
-                input.sequence());
-
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ////ins[input_index].set_sequence(self.sequence());
+        sink.write_8_bytes_little_endian(output::not_found);
+        sink.write_variable_little_endian(0);
     }
 
-    // Move new inputs and copy outputs to new transaction.
-    transaction out(tx.version(), tx.locktime(), input::list{}, tx.outputs());
-    out.set_inputs(std::move(ins));
-    return signature_hash(out, sighash_type);
+    outputs[input_index].to_data(sink, true);
+
+    sink.write_4_bytes_little_endian(tx.locktime());
+    sink.write_4_bytes_little_endian(sighash_type);
+    return sink.bitcoin_hash();
 }
 
-static script strip_code_seperators(const script& script_code)
+static hash_digest sign_all(const transaction& tx, uint32_t input_index,
+    const script& script_code, uint8_t sighash_type)
 {
-    operation::list ops;
+    sha256_writer sink;
+    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
 
-    for (auto op = script_code.begin(); op != script_code.end(); ++op)
-        if (op->code() != opcode::codeseparator)
-            ops.push_back(*op);
+    sink.write_4_bytes_little_endian(tx.version());
+    write_inputs(sink, tx, input_index, script_code, any, true);
+
+    // Retain all outputs.
+    const auto& outputs = tx.outputs();
+    sink.write_variable_little_endian(outputs.size());
+
+    for (const auto& output: outputs)
+        output.to_data(sink, true);
 
-    return script(std::move(ops));
+    sink.write_4_bytes_little_endian(tx.locktime());
+    sink.write_4_bytes_little_endian(sighash_type);
+    return sink.bitcoin_hash();
 }
 
 // private/static
@@ -646,21 +631,17 @@ hash_digest script::generate_unversioned_signature_hash(const transaction& tx,
         return one_hash;
     }
 
-    //*************************************************************************
-    // CONSENSUS: more wacky satoshi behavior.
-    //*************************************************************************
-    const auto stripped = strip_code_seperators(script_code);
-
     // The sighash serializations are isolated for clarity and optimization.
+    // The preimage is streamed into the hash, the transaction is not copied.
     switch (sighash)
     {
         case sighash_algorithm::none:
-            return sign_none(tx, input_index, stripped, sighash_type);
+            return sign_none(tx, input_index, script_code, sighash_type);
         case sighash_algorithm::single:
-            return sign_single(tx, input_index, stripped, sighash_type);
+            return sign_single(tx, input_index, script_code, sighash_type);
         default:
         case sighash_algorithm::all:
-            return sign_all(tx, input_index, stripped, sighash_type);
+            return sign_all(tx, input_index, script_code, sighash_type);
     }
 }
 
@@ -669,91 +650,39 @@ hash_digest script::generate_unversioned_signature_hash(const transaction& tx,
 
 hash_digest script::to_outputs(const transaction& tx)
 {
-    const auto sum = [&](size_t total, const output& output)
-    {
-        return total + output.serialized_size();
-    };
-
-    const auto& outs = tx.outputs();
-    auto size = std::accumulate(outs.begin(), outs.end(), size_t(0), sum);
-    data_chunk data;
-    data.reserve(size);
-    data_sink ostream(data);
-    ostream_writer sink(ostream);
+    sha256_writer sink;
 
-    const auto write = [&](const output& output)
-    {
+    for (const auto& output: tx.outputs())
         output.to_data(sink, true);
-    };
 
-    std::for_each(outs.begin(), outs.end(), write);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
-    return bitcoin_hash(data);
+    return sink.bitcoin_hash();
 }
 
 hash_digest script::to_inpoints(const transaction& tx)
 {
-    const auto sum = [&](size_t total, const input& input)
-    {
-        return total + input.previous_output().serialized_size();
-    };
+    sha256_writer sink;
 
-    const auto& ins = tx.inputs();
-    auto size = std::accumulate(ins.begin(), ins.end(), size_t(0), sum);
-    data_chunk data;
-    data.reserve(size);
-    data_sink ostream(data);
-    ostream_writer sink(ostream);
-
-    const auto write = [&](const input& input)
-    {
+    for (const auto& input: tx.inputs())
         input.previous_output().to_data(sink);
-    };
 
-    std::for_each(ins.begin(), ins.end(), write);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
-    return bitcoin_hash(data);
+    return sink.bitcoin_hash();
 }
 
 hash_digest script::to_sequences(const transaction& tx)
 {
-    const auto sum = [&](size_t total, const input& input)
-    {
-        return total + sizeof(uint32_t);
-    };
-
-    const auto& ins = tx.inputs();
-    auto size = std::accumulate(ins.begin(), ins.end(), size_t(0), sum);
-    data_chunk data;
-    data.reserve(size);
-    data_sink ostream(data);
-    ostream_writer sink(ostream);
+    sha256_writer sink;
 
-    const auto write = [&](const input& input)
-    {
+    for (const auto& input: tx.inputs())
         sink.write_4_bytes_little_endian(input.sequence());
-    };
 
-    std::for_each(ins.begin(), ins.end(), write);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
-    return bitcoin_hash(data);
+    return sink.bitcoin_hash();
 }
 
-static size_t preimage_size(size_t script_size)
+static hash_digest to_output(const output& output)
 {
-    return sizeof(uint32_t)
-        + hash_size
-        + hash_size
-        + point::satoshi_fixed_size()
-        + script_size
-        + sizeof(uint64_t)
-        + sizeof(uint32_t)
-        + hash_size
-        + sizeof(uint32_t)
-        + sizeof(uint32_t);
+    sha256_writer sink;
+    output.to_data(sink, true);
+    return sink.bitcoin_hash();
 }
 
 // private/static
@@ -764,12 +693,9 @@ hash_digest script::generate_version_0_signature_hash(const transaction& tx,
     // Unlike unversioned algorithm this does not allow an invalid input index.
     BITCOIN_ASSERT(input_index < tx.inputs().size());
     const auto& input = tx.inputs()[input_index];
-    const auto size = preimage_size(script_code.serialized_size(true));
 
-    data_chunk data;
-    data.reserve(size);
-    data_sink ostream(data);
-    ostream_writer sink(ostream);
+    // The preimage is streamed into the hash, it is not materialized.
+    sha256_writer sink;
 
     // Flags derived from the signature hash byte.
     const auto sighash = to_sighash_enum(sighash_type);
@@ -779,7 +705,7 @@ hash_digest script::generate_version_0_signature_hash(const transaction& tx,
     const auto all = (sighash == sighash_algorithm::all);
 
     // 1. transaction version (4-byte little endian).
-    sink.write_little_endian(tx.version());
+    sink.write_4_bytes_little_endian(tx.version());
 
     // 2. inpoints hash (32-byte hash).
     sink.write_hash(!any ? tx.inpoints_hash() : null_hash);
@@ -794,25 +720,22 @@ hash_digest script::generate_version_0_signature_hash(const transaction& tx,
     script_code.to_data(sink, true);
 
     // 6. value of the output spent by this input (8-byte little endian).
-    sink.write_little_endian(value);
+    sink.write_8_bytes_little_endian(value);
 
     // 7. sequence of the input (4-byte little endian).
-    sink.write_little_endian(input.sequence());
+    sink.write_4_bytes_little_endian(input.sequence());
 
     // 8. outputs hash (32-byte hash).
     sink.write_hash(all ? tx.outputs_hash() :
         (single && input_index < tx.outputs().size() ?
-            bitcoin_hash(tx.outputs()[input_index].to_data()) : null_hash));
+            to_output(tx.outputs()[input_index]) : null_hash));
 
     // 9. transaction locktime (4-byte little endian).
-    sink.write_little_endian(tx.locktime());
+    sink.write_4_bytes_little_endian(tx.locktime());
 
     // 10. sighash type of the signature (4-byte [not 1] little endian).
     sink.write_4_bytes_little_endian(sighash_type);
-
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
-    return bitcoin_hash(data);
+    return sink.bitcoin_hash();
 }
 
 // Signing (common).
@@ -843,7 +766,7 @@ hash_digest script::generate_signature_hash(const transaction& tx,
 bool script::check_signature(const ec_signature& signature,
     uint8_t sighash_type, const data_chunk& public_key,
     const script& script_code, const transaction& tx, uint32_t input_index,
-    script_version version, uint64_t value)
+    script_version version, uint64_t value, signature_cache* cache)
 {
     if (public_key.empty())
         return false;
@@ -852,8 +775,18 @@ bool script::check_signature(const ec_signature& signature,
     const auto sighash = chain::script::generate_signature_hash(tx,
         input_index, script_code, sighash_type, version, value);
 
-    // Validate the EC signature.
-    return verify_signature(public_key, sighash, signature);
+    if (cache == nullptr)
+        return verify_signature(public_key, sighash, signature);
+
+    if (cache->contains(sighash, public_key, signature))
+        return true;
+
+    // Validate the EC signature, only successes are cached.
+    if (!verify_signature(public_key, sighash, signature))
+        return false;
+
+    cache->store(sighash, public_key, signature);
+    return true;
 }
 
 // static
@@ -1206,20 +1139,21 @@ script_pattern script::pattern() const
 // The bip141 coinbase pattern is not tested here, must test independently.
 script_pattern script::output_pattern() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    if (is_pay_key_hash_pattern(operations()))
+    const auto& ops = operations();
+
+    if (is_pay_key_hash_pattern(ops))
         return script_pattern::pay_key_hash;
 
-    if (is_pay_script_hash_pattern(operations_))
+    if (is_pay_script_hash_pattern(ops))
         return script_pattern::pay_script_hash;
 
-    if (is_pay_null_data_pattern(operations_))
+    if (is_pay_null_data_pattern(ops))
         return script_pattern::pay_null_data;
 
-    if (is_pay_public_key_pattern(operations_))
+    if (is_pay_public_key_pattern(ops))
         return script_pattern::pay_public_key;
 
-    if (is_pay_multisig_pattern(operations_))
+    if (is_pay_multisig_pattern(ops))
         return script_pattern::pay_multisig;
 
     return script_pattern::non_standard;
@@ -1229,18 +1163,19 @@ script_pattern script::output_pattern() const
 // The bip34 coinbase pattern is not tested here, must test independently.
 script_pattern script::input_pattern() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    if (is_sign_key_hash_pattern(operations()))
+    const auto& ops = operations();
+
+    if (is_sign_key_hash_pattern(ops))
         return script_pattern::sign_key_hash;
 
     // This must follow is_sign_key_hash_pattern for ambiguity comment to hold.
-    if (is_sign_script_hash_pattern(operations_))
+    if (is_sign_script_hash_pattern(ops))
         return script_pattern::sign_script_hash;
 
-    if (is_sign_public_key_pattern(operations_))
+    if (is_sign_public_key_pattern(ops))
         return script_pattern::sign_public_key;
 
-    if (is_sign_multisig_pattern(operations_))
+    if (is_sign_multisig_pattern(ops))
         return script_pattern::sign_multisig;
 
     return script_pattern::non_standard;
@@ -1271,10 +1206,14 @@ inline size_t multisig_sigops(bool accurate, opcode code)
 
 size_t script::sigops(bool accurate) const
 {
+    // Scripts are counted (e.g. all block outputs) far more than evaluated.
+    // So avoid creating the operations cache if not already populated.
+    if (!operations_.is_set())
+        return decoded_script(bytes_).sigops(accurate);
+
     size_t total = 0;
     auto preceding = opcode::push_negative_1;
 
-    // The first operations access must be method-based to guarantee the cache.
     for (const auto& op: operations())
     {
         const auto code = op.code();
@@ -1345,8 +1284,7 @@ void script::find_and_delete(const data_stack& endorsements)
         find_and_delete_(endorsement);
 
     // Invalidate the cache so that the operations may be regenerated.
-    operations_.clear();
-    cached_ = false;
+    operations_.reset();
     bytes_.shrink_to_fit();
 }
 
@@ -1369,8 +1307,8 @@ void script::find_and_delete(const data_stack& endorsements)
 // The criteria below are not be comprehensive but are fast to evaluate.
 bool script::is_unspendable() const
 {
-    // The first operations access must be method-based to guarantee the cache.
-    return (!operations().empty() && operations_[0].code() == opcode::return_)
+    const auto& ops = operations();
+    return (!ops.empty() && ops.front().code() == opcode::return_)
         || serialized_size(false) > max_script_size;
 }
 
@@ -1379,13 +1317,14 @@ bool script::is_unspendable() const
 
 code script::verify(const transaction& tx, uint32_t input_index,
     uint32_t forks, const script& input_script, const witness& input_witness,
-    const script& prevout_script, uint64_t value)
+    const script& prevout_script, uint64_t value, signature_queue* deferred,
+    signature_cache* cache)
 {
     code ec;
     bool witnessed;
 
     // Evaluate input script.
-    program input(input_script, tx, input_index, forks);
+    program input(input_script, tx, input_index, forks, deferred, cache);
     if ((ec = input.evaluate()))
         return ec;
 
@@ -1407,7 +1346,7 @@ code script::verify(const transaction& tx, uint32_t input_index,
 
         // This is a valid witness script so validate it.
         if ((ec = input_witness.verify(tx, input_index, forks,
-            prevout_script, value)))
+            prevout_script, value, deferred, cache)))
             return ec;
     }
 
@@ -1437,7 +1376,7 @@ code script::verify(const transaction& tx, uint32_t input_index,
 
             // This is a valid embedded witness script so validate it.
             if ((ec = input_witness.verify(tx, input_index, forks,
-                embedded_script, value)))
+                embedded_script, value, deferred, cache)))
                 return ec;
         }
     }
@@ -1449,7 +1388,8 @@ code script::verify(const transaction& tx, uint32_t input_index,
     return error::success;
 }
 
-code script::verify(const transaction& tx, uint32_t input, uint32_t forks)
+code script::verify(const transaction& tx, uint32_t input, uint32_t forks,
+    signature_queue* deferred, signature_cache* cache)
 {
     if (input >= tx.inputs().size())
         return error::operation_failed;
@@ -1457,7 +1397,7 @@ code script::verify(const transaction& tx, uint32_t input, uint32_t forks)
     const auto& in = tx.inputs()[input];
     const auto& prevout = in.previous_output().validation.cache;
     return verify(tx, input, forks, in.script(), in.witness(),
-        prevout.script(), prevout.value());
+        prevout.script(), prevout.value(), deferred, cache);
 }
 
 } // namespace chain
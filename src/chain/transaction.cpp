@@ -39,6 +39,8 @@
 #include <bitcoin/bitcoin/machine/opcode.hpp>
 #include <bitcoin/bitcoin/machine/operation.hpp>
 #include <bitcoin/bitcoin/machine/rule_fork.hpp>
+#include <bitcoin/bitcoin/machine/script_cache.hpp>
+#include <bitcoin/bitcoin/machine/signature_cache.hpp>
 #include <bitcoin/bitcoin/message/messages.hpp>
 #include <bitcoin/bitcoin/utility/collection.hpp>
 #include <bitcoin/bitcoin/utility/container_sink.hpp>
@@ -46,6 +48,7 @@
 #include <bitcoin/bitcoin/utility/endian.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/sha256_writer.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -68,7 +71,7 @@ bool read(Source& source, std::vector<Put>& puts, bool wire, bool witness)
     const auto deserialize = [&](Put& put)
     {
         result = result && put.from_data(source, wire, witness);
-#ifndef NDBEUG
+#ifndef NDEBUG
         put.script().operations();
 #endif
     };
@@ -92,7 +95,8 @@ void write(Sink& sink, const std::vector<Put>& puts, bool wire, bool witness)
 }
 
 // Input list must be pre-populated as it determines witness count.
-inline void read_witnesses(reader& source, input::list& inputs)
+template<class Source>
+void read_witnesses(Source& source, input::list& inputs)
 {
     const auto deserialize = [&](input& input)
     {
@@ -103,7 +107,8 @@ inline void read_witnesses(reader& source, input::list& inputs)
 }
 
 // Witness count is not written as it is inferred from input count.
-inline void write_witnesses(writer& sink, const input::list& inputs)
+template<class Sink>
+void write_witnesses(Sink& sink, const input::list& inputs)
 {
     const auto serialize = [&sink](const input& input)
     {
@@ -113,6 +118,14 @@ inline void write_witnesses(writer& sink, const input::list& inputs)
     std::for_each(inputs.begin(), inputs.end(), serialize);
 }
 
+// Stream the wire serialization into the hash (no data_chunk is created).
+inline hash_digest wire_hash(const transaction& tx, bool witness)
+{
+    sha256_writer sink;
+    tx.to_data(sink, true, witness);
+    return sink.bitcoin_hash();
+}
+
 // Constructors.
 //-----------------------------------------------------------------------------
 
@@ -122,25 +135,27 @@ transaction::transaction()
 }
 
 transaction::transaction(transaction&& other)
-  : hash_(other.hash_cache()),
-    total_input_value_(other.total_input_value_cache()),
-    total_output_value_(other.total_output_value_cache()),
+  : hash_(other.hash_),
+    total_input_value_(other.total_input_value_),
+    total_output_value_(other.total_output_value_),
     version_(other.version_),
     locktime_(other.locktime_),
     inputs_(std::move(other.inputs_)),
     outputs_(std::move(other.outputs_)),
+    stripped_(other.stripped_),
     validation(std::move(other.validation))
 {
 }
 
 transaction::transaction(const transaction& other)
-  : hash_(other.hash_cache()),
-    total_input_value_(other.total_input_value_cache()),
-    total_output_value_(other.total_output_value_cache()),
+  : hash_(other.hash_),
+    total_input_value_(other.total_input_value_),
+    total_output_value_(other.total_output_value_),
     version_(other.version_),
     locktime_(other.locktime_),
     inputs_(other.inputs_),
     outputs_(other.outputs_),
+    stripped_(other.stripped_),
     validation(other.validation)
 {
 }
@@ -151,6 +166,7 @@ transaction::transaction(uint32_t version, uint32_t locktime,
     locktime_(locktime),
     inputs_(std::move(inputs)),
     outputs_(std::move(outputs)),
+    stripped_(false),
     validation{}
 {
 }
@@ -161,43 +177,24 @@ transaction::transaction(uint32_t version, uint32_t locktime,
     locktime_(locktime),
     inputs_(inputs),
     outputs_(outputs),
+    stripped_(false),
     validation{}
 {
 }
 
-// Private cache access for copy/move construction.
-transaction::hash_ptr transaction::hash_cache() const
-{
-    shared_lock lock(mutex_);
-    return hash_;
-}
-
-// Private cache access for copy/move construction.
-transaction::optional_value transaction::total_input_value_cache() const
-{
-    shared_lock lock(mutex_);
-    return total_input_value_;
-}
-
-// Private cache access for copy/move construction.
-transaction::optional_value transaction::total_output_value_cache() const
-{
-    shared_lock lock(mutex_);
-    return total_output_value_;
-}
-
 // Operators.
 //-----------------------------------------------------------------------------
 
 transaction& transaction::operator=(transaction&& other)
 {
-    hash_ = other.hash_cache();
-    total_input_value_ = other.total_input_value_cache();
-    total_output_value_ = other.total_output_value_cache();
+    hash_ = other.hash_;
+    total_input_value_ = other.total_input_value_;
+    total_output_value_ = other.total_output_value_;
     version_ = other.version_;
     locktime_ = other.locktime_;
     inputs_ = std::move(other.inputs_);
     outputs_ = std::move(other.outputs_);
+    stripped_ = other.stripped_;
     validation = std::move(other.validation);
     return *this;
 }
@@ -205,13 +202,14 @@ transaction& transaction::operator=(transaction&& other)
 // This can be expensive, try to avoid.
 transaction& transaction::operator=(const transaction& other)
 {
-    hash_ = other.hash_cache();
-    total_input_value_ = other.total_input_value_cache();
-    total_output_value_ = other.total_output_value_cache();
+    hash_ = other.hash_;
+    total_input_value_ = other.total_input_value_;
+    total_output_value_ = other.total_output_value_;
     version_ = other.version_;
     locktime_ = other.locktime_;
     inputs_ = other.inputs_;
     outputs_ = other.outputs_;
+    stripped_ = other.stripped_;
     validation = other.validation;
     return *this;
 }
@@ -278,8 +276,9 @@ transaction transaction::factory(reader& source, const hash_digest& hash,
 
 bool transaction::from_data(const data_chunk& data, bool wire, bool witness)
 {
-    data_source istream(data);
-    return from_data(istream, wire, witness);
+    const auto begin = data.data();
+    auto source = make_safe_deserializer(begin, begin + data.size());
+    return from_data(source, wire, witness);
 }
 
 bool transaction::from_data(std::istream& stream, bool wire, bool witness)
@@ -288,8 +287,10 @@ bool transaction::from_data(std::istream& stream, bool wire, bool witness)
     return from_data(source, wire, witness);
 }
 
+// private
 // Witness is not used by outputs, just for template normalization.
-bool transaction::from_data(reader& source, bool wire, bool witness)
+template <class Source>
+bool transaction::deserialize(Source& source, bool wire, bool witness)
 {
     reset();
 
@@ -345,17 +346,27 @@ bool transaction::from_data(reader& source, bool wire, bool witness)
     return source;
 }
 
+bool transaction::from_data(reader& source, bool wire, bool witness)
+{
+    return deserialize(source, wire, witness);
+}
+
+bool transaction::from_data(byte_deserializer& source, bool wire, bool witness)
+{
+    return deserialize(source, wire, witness);
+}
+
 bool transaction::from_data(reader& source, hash_digest&& hash, bool wire,
     bool witness)
 {
-    hash_ = std::make_shared<hash_digest>(std::move(hash));
+    hash_.set(std::move(hash));
     return from_data(source, wire, witness);
 }
 
 bool transaction::from_data(reader& source, const hash_digest& hash, bool wire,
     bool witness)
 {
-    hash_ = std::make_shared<hash_digest>(hash);
+    hash_.set(hash);
     return from_data(source, wire, witness);
 }
 
@@ -372,9 +383,9 @@ void transaction::reset()
     outputs_hash_.reset();
     inpoints_hash_.reset();
     sequences_hash_.reset();
-    segregated_ = boost::none;
-    total_input_value_ = boost::none;
-    total_output_value_ = boost::none;
+    stripped_ = false;
+    total_input_value_.reset();
+    total_output_value_.reset();
 }
 
 bool transaction::is_valid() const
@@ -393,17 +404,9 @@ data_chunk transaction::to_data(bool wire, bool witness) const
     // Witness handling must be disabled for non-segregated txs.
     witness &= is_segregated();
 
-    data_chunk data;
-    const auto size = serialized_size(wire, witness);
-
-    // Reserve an extra byte to prevent full reallocation in the case of
-    // generate_signature_hash extension by addition of the sighash_type.
-    data.reserve(size + sizeof(uint8_t));
-
-    data_sink ostream(data);
-    to_data(ostream, wire, witness);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
+    data_chunk data(serialized_size(wire, witness));
+    auto sink = make_unsafe_serializer(data.data());
+    to_data(sink, wire, witness);
     return data;
 }
 
@@ -416,8 +419,10 @@ void transaction::to_data(std::ostream& stream, bool wire, bool witness) const
     to_data(sink, wire, witness);
 }
 
+// private
 // Witness is not used by outputs, just for template normalization.
-void transaction::to_data(writer& sink, bool wire, bool witness) const
+template <class Sink>
+void transaction::serialize(Sink& sink, bool wire, bool witness) const
 {
     if (wire)
     {
@@ -454,6 +459,16 @@ void transaction::to_data(writer& sink, bool wire, bool witness) const
     }
 }
 
+void transaction::to_data(writer& sink, bool wire, bool witness) const
+{
+    serialize(sink, wire, witness);
+}
+
+void transaction::to_data(byte_serializer& sink, bool wire, bool witness) const
+{
+    serialize(sink, wire, witness);
+}
+
 // Size.
 //-----------------------------------------------------------------------------
 
@@ -526,16 +541,16 @@ void transaction::set_inputs(const input::list& value)
     invalidate_cache();
     inpoints_hash_.reset();
     sequences_hash_.reset();
-    segregated_ = boost::none;
-    total_input_value_ = boost::none;
+    stripped_ = false;
+    total_input_value_.reset();
 }
 
 void transaction::set_inputs(input::list&& value)
 {
     inputs_ = std::move(value);
     invalidate_cache();
-    segregated_ = boost::none;
-    total_input_value_ = boost::none;
+    stripped_ = false;
+    total_input_value_.reset();
 }
 
 output::list& transaction::outputs()
@@ -553,14 +568,14 @@ void transaction::set_outputs(const output::list& value)
     outputs_ = value;
     invalidate_cache();
     outputs_hash_.reset();
-    total_output_value_ = boost::none;
+    total_output_value_.reset();
 }
 
 void transaction::set_outputs(output::list&& value)
 {
     outputs_ = std::move(value);
     invalidate_cache();
-    total_output_value_ = boost::none;
+    total_output_value_.reset();
 }
 
 // Cache.
@@ -569,22 +584,8 @@ void transaction::set_outputs(output::list&& value)
 // protected
 void transaction::invalidate_cache() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if (hash_ || witness_hash_)
-    {
-        hash_mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_.reset();
-        witness_hash_.reset();
-        //---------------------------------------------------------------------
-        hash_mutex_.unlock_and_lock_upgrade();
-    }
-
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
+    hash_.reset();
+    witness_hash_.reset();
 }
 
 hash_digest transaction::hash(bool witness) const
@@ -592,111 +593,43 @@ hash_digest transaction::hash(bool witness) const
     // Witness hashing must be disabled for non-segregated txs.
     witness &= is_segregated();
 
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
     if (witness)
     {
-        if (!witness_hash_)
+        // Witness coinbase tx hash is assumed to be null_hash (bip141).
+        return witness_hash_.get([this]()
         {
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            hash_mutex_.unlock_upgrade_and_lock();
-
-            // Witness coinbase tx hash is assumed to be null_hash (bip141).
-            witness_hash_ = std::make_shared<hash_digest>(
-                is_coinbase() ? null_hash : bitcoin_hash(to_data(true, true)));
-
-            hash_mutex_.unlock_and_lock_upgrade();
-            //-----------------------------------------------------------------
-        }
+            return is_coinbase() ? null_hash : wire_hash(*this, true);
+        });
     }
-    else
-    {
-        if (!hash_)
-        {
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            hash_mutex_.unlock_upgrade_and_lock();
-            hash_ = std::make_shared<hash_digest>(bitcoin_hash(to_data(true)));
-            hash_mutex_.unlock_and_lock_upgrade();
-            //-----------------------------------------------------------------
-        }
-    }
-
-    const auto hash = witness ? *witness_hash_ : *hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
 
-    return hash;
+    return hash_.get([this]()
+    {
+        return wire_hash(*this, false);
+    });
 }
 
 hash_digest transaction::outputs_hash() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if (!outputs_hash_)
+    return outputs_hash_.get([this]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        outputs_hash_ = std::make_shared<hash_digest>(
-            script::to_outputs(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    const auto hash = *outputs_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
+        return script::to_outputs(*this);
+    });
 }
 
 hash_digest transaction::inpoints_hash() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if (!inpoints_hash_)
+    return inpoints_hash_.get([this]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        inpoints_hash_ = std::make_shared<hash_digest>(
-            script::to_inpoints(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    const auto hash = *inpoints_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
+        return script::to_inpoints(*this);
+    });
 }
 
 hash_digest transaction::sequences_hash() const
 {
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if (!sequences_hash_)
+    return sequences_hash_.get([this]()
     {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        sequences_hash_ = std::make_shared<hash_digest>(
-            script::to_sequences(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    const auto hash = *sequences_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
+        return script::to_sequences(*this);
+    });
 }
 
 // Utilities.
@@ -710,13 +643,8 @@ void transaction::strip_witness()
         input.strip_witness();
     };
 
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    unique_lock lock(mutex_);
-
-    segregated_ = false;
+    stripped_ = true;
     std::for_each(inputs_.begin(), inputs_.end(), strip);
-    ///////////////////////////////////////////////////////////////////////////
 }
 
 // Validation helpers.
@@ -797,23 +725,6 @@ bool transaction::is_locktime_conflict() const
 // Returns max_uint64 in case of overflow.
 uint64_t transaction::total_input_value() const
 {
-    uint64_t value;
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (total_input_value_ != boost::none)
-    {
-        value = total_input_value_.get();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
     ////static_assert(max_money() < max_uint64, "overflow sentinel invalid");
     const auto sum = [](uint64_t total, const input& input)
     {
@@ -824,46 +735,27 @@ uint64_t transaction::total_input_value() const
         return ceiling_add(total, missing ? 0 : prevout.value());
     };
 
-    value = std::accumulate(inputs_.begin(), inputs_.end(), uint64_t(0), sum);
-    total_input_value_ = value;
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
+    return total_input_value_.get([this, &sum]()
+    {
+        return std::accumulate(inputs_.begin(), inputs_.end(), uint64_t(0),
+            sum);
+    });
 }
 
 // Returns max_uint64 in case of overflow.
 uint64_t transaction::total_output_value() const
 {
-    uint64_t value;
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (total_output_value_ != boost::none)
-    {
-        value = total_output_value_.get();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
     ////static_assert(max_money() < max_uint64, "overflow sentinel invalid");
     const auto sum = [](uint64_t total, const output& output)
     {
         return ceiling_add(total, output.value());
     };
 
-    value = std::accumulate(outputs_.begin(), outputs_.end(), uint64_t(0), sum);
-    total_output_value_ = value;
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
+    return total_output_value_.get([this, &sum]()
+    {
+        return std::accumulate(outputs_.begin(), outputs_.end(),
+            uint64_t(0), sum);
+    });
 }
 
 uint64_t transaction::fees() const
@@ -1012,22 +904,9 @@ bool transaction::is_mature(size_t height) const
 
 bool transaction::is_segregated() const
 {
-    bool value;
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (segregated_ != boost::none)
-    {
-        value = segregated_.get();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    // Not cached, since witnesses are mutable through inputs().
+    if (stripped_)
+        return false;
 
     const auto segregated = [](const input& input)
     {
@@ -1035,16 +914,13 @@ bool transaction::is_segregated() const
     };
 
     // If no block tx is has witness data the commitment is optional (bip141).
-    value = std::any_of(inputs_.begin(), inputs_.end(), segregated);
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
+    return std::any_of(inputs_.begin(), inputs_.end(), segregated);
 }
 
 // Coinbase transactions return success, to simplify iteration.
 code transaction::connect_input(const chain_state& state,
-    size_t input_index) const
+    size_t input_index, signature_queue* deferred,
+    signature_cache* cache) const
 {
     if (input_index >= inputs_.size())
         return error::operation_failed;
@@ -1062,7 +938,7 @@ code transaction::connect_input(const chain_state& state,
     const auto index32 = static_cast<uint32_t>(input_index);
 
     // Verify the transaction input script against the previous output.
-    return script::verify(*this, index32, forks);
+    return script::verify(*this, index32, forks, deferred, cache);
 }
 
 // Validation.
@@ -1182,14 +1058,23 @@ code transaction::connect() const
     return state ? connect(*state) : error::operation_failed;
 }
 
-code transaction::connect(const chain_state& state) const
+code transaction::connect(const chain_state& state,
+    signature_cache* cache, script_cache* scripts) const
 {
     code ec;
+    const auto forks = state.enabled_forks();
+
+    // Script results depend upon the witness and the enabled forks.
+    if (scripts != nullptr && scripts->contains(hash(true), forks))
+        return error::success;
 
     for (size_t input = 0; input < inputs_.size(); ++input)
-        if ((ec = connect_input(state, input)))
+        if ((ec = connect_input(state, input, nullptr, cache)))
             return ec;
 
+    if (scripts != nullptr)
+        scripts->store(hash(true), forks);
+
     return error::success;
 }
 
@@ -0,0 +1,333 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/chain/transaction_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/chain/output_point.hpp>
+#include <bitcoin/bitcoin/chain/point.hpp>
+#include <bitcoin/bitcoin/chain/transaction.hpp>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/sha256_writer.hpp>
+
+namespace libbitcoin {
+namespace chain {
+
+static constexpr size_t point_size = hash_size + sizeof(uint32_t);
+
+// A bounds checked forward cursor over the buffer.
+class cursor
+{
+public:
+    cursor(const uint8_t* begin, const uint8_t* end)
+      : begin_(begin), it_(begin), end_(end), valid_(true)
+    {
+    }
+
+    operator bool() const
+    {
+        return valid_;
+    }
+
+    uint32_t offset() const
+    {
+        return static_cast<uint32_t>(it_ - begin_);
+    }
+
+    bool skip(size_t size)
+    {
+        if (!valid_ || size > static_cast<size_t>(end_ - it_))
+            return (valid_ = false);
+
+        it_ += size;
+        return true;
+    }
+
+    uint8_t peek_byte()
+    {
+        if (!valid_ || it_ == end_)
+            return (valid_ = false);
+
+        return *it_;
+    }
+
+    template <typename Integer>
+    Integer read_little_endian()
+    {
+        const auto start = it_;
+        return skip(sizeof(Integer)) ?
+            from_little_endian_unsafe<Integer>(start) : 0;
+    }
+
+    // Non-minimal encodings are invalid, so that the bytes are canonical.
+    size_t read_size()
+    {
+        uint64_t value = read_little_endian<uint8_t>();
+
+        switch (value)
+        {
+            case varint_two_bytes:
+                value = read_little_endian<uint16_t>();
+                valid_ &= value >= varint_two_bytes;
+                break;
+            case varint_four_bytes:
+                value = read_little_endian<uint32_t>();
+                valid_ &= value > max_uint16;
+                break;
+            case varint_eight_bytes:
+                value = read_little_endian<uint64_t>();
+                valid_ &= value > max_uint32;
+                break;
+            default:
+                break;
+        }
+
+        // No count or size can exceed the buffer, this guards overflow.
+        valid_ &= value <= static_cast<uint64_t>(end_ - begin_);
+        return valid_ ? static_cast<size_t>(value) : 0;
+    }
+
+private:
+    const uint8_t* const begin_;
+    const uint8_t* it_;
+    const uint8_t* const end_;
+    bool valid_;
+};
+
+transaction_view::transaction_view(data_slice buffer)
+  : begin_(buffer.begin()),
+    end_(buffer.end()),
+    valid_(false),
+    marker_(false),
+    segregated_(false),
+    outputs_end_(0)
+{
+    // Offsets are 32 bit, which is sufficient for any transaction.
+    if (buffer.size() > max_uint32)
+        return;
+
+    valid_ = parse();
+
+    if (!valid_)
+    {
+        end_ = begin_;
+        inputs_.clear();
+        outputs_.clear();
+    }
+}
+
+// Mirrors wire deserialization of transaction.
+bool transaction_view::parse()
+{
+    cursor source(begin_, end_);
+    source.skip(sizeof(uint32_t));
+
+    auto count = source.read_size();
+
+    // Detect witness as no inputs (marker) and expected flag (bip144).
+    if (count == witness_marker && source.peek_byte() == witness_flag)
+    {
+        marker_ = true;
+        source.skip(1);
+        count = source.read_size();
+    }
+
+    inputs_.reserve(count);
+
+    for (size_t index = 0; source && index < count; ++index)
+    {
+        input_record input;
+        input.point = source.offset();
+        source.skip(point_size);
+        const auto size = source.read_size();
+        input.script = { source.offset(), static_cast<uint32_t>(size) };
+        source.skip(size);
+        source.skip(sizeof(uint32_t));
+        input.witness = { 0, 0 };
+        inputs_.push_back(input);
+    }
+
+    count = source.read_size();
+    outputs_.reserve(count);
+
+    for (size_t index = 0; source && index < count; ++index)
+    {
+        output_record output;
+        output.value = source.offset();
+        source.skip(sizeof(uint64_t));
+        const auto size = source.read_size();
+        output.script = { source.offset(), static_cast<uint32_t>(size) };
+        source.skip(size);
+        outputs_.push_back(output);
+    }
+
+    outputs_end_ = source.offset();
+
+    if (marker_)
+    {
+        for (auto& input: inputs_)
+        {
+            const auto start = source.offset();
+            auto elements = source.read_size();
+            segregated_ |= elements != 0;
+
+            for (; source && elements > 0; --elements)
+                source.skip(source.read_size());
+
+            input.witness = { start, source.offset() - start };
+        }
+    }
+
+    source.skip(sizeof(uint32_t));
+
+    if (!source)
+        return false;
+
+    end_ = begin_ + source.offset();
+    return true;
+}
+
+bool transaction_view::is_valid() const
+{
+    return valid_;
+}
+
+data_slice transaction_view::data() const
+{
+    return{ begin_, end_ };
+}
+
+size_t transaction_view::serialized_size() const
+{
+    return static_cast<size_t>(end_ - begin_);
+}
+
+uint32_t transaction_view::version() const
+{
+    BITCOIN_ASSERT(valid_);
+    return from_little_endian_unsafe<uint32_t>(begin_);
+}
+
+uint32_t transaction_view::locktime() const
+{
+    BITCOIN_ASSERT(valid_);
+    return from_little_endian_unsafe<uint32_t>(end_ - sizeof(uint32_t));
+}
+
+bool transaction_view::is_coinbase() const
+{
+    return inputs_.size() == 1 && previous_output(0).is_null();
+}
+
+bool transaction_view::is_segregated() const
+{
+    return segregated_;
+}
+
+hash_digest transaction_view::hash(bool witness) const
+{
+    BITCOIN_ASSERT(valid_);
+
+    if (witness && segregated_)
+    {
+        // Witness coinbase tx hash is assumed to be null_hash (bip141).
+        return is_coinbase() ? null_hash : bitcoin_hash(data());
+    }
+
+    if (!marker_)
+        return bitcoin_hash(data());
+
+    // Exclude the marker, flag and witnesses.
+    static constexpr size_t stripped = sizeof(uint32_t) + 2;
+    sha256_writer sink;
+    sink.write_bytes(begin_, sizeof(uint32_t));
+    sink.write_bytes(begin_ + stripped, outputs_end_ - stripped);
+    sink.write_bytes(end_ - sizeof(uint32_t), sizeof(uint32_t));
+    return sink.bitcoin_hash();
+}
+
+size_t transaction_view::inputs() const
+{
+    return inputs_.size();
+}
+
+output_point transaction_view::previous_output(size_t index) const
+{
+    BITCOIN_ASSERT(index < inputs_.size());
+    const auto start = begin_ + inputs_[index].point;
+    hash_digest hash;
+    std::copy(start, start + hash_size, hash.begin());
+    return{ hash, from_little_endian_unsafe<uint32_t>(start + hash_size) };
+}
+
+data_slice transaction_view::input_script(size_t index) const
+{
+    BITCOIN_ASSERT(index < inputs_.size());
+    return slice(inputs_[index].script);
+}
+
+uint32_t transaction_view::sequence(size_t index) const
+{
+    BITCOIN_ASSERT(index < inputs_.size());
+    const auto& script = inputs_[index].script;
+    return from_little_endian_unsafe<uint32_t>(begin_ + script.offset +
+        script.size);
+}
+
+data_slice transaction_view::witness(size_t index) const
+{
+    BITCOIN_ASSERT(index < inputs_.size());
+    return slice(inputs_[index].witness);
+}
+
+size_t transaction_view::outputs() const
+{
+    return outputs_.size();
+}
+
+uint64_t transaction_view::value(size_t index) const
+{
+    BITCOIN_ASSERT(index < outputs_.size());
+    return from_little_endian_unsafe<uint64_t>(begin_ + outputs_[index].value);
+}
+
+data_slice transaction_view::output_script(size_t index) const
+{
+    BITCOIN_ASSERT(index < outputs_.size());
+    return slice(outputs_[index].script);
+}
+
+transaction transaction_view::to_transaction(bool witness) const
+{
+    BITCOIN_ASSERT(valid_);
+    return transaction::factory(to_chunk(data()), true, witness);
+}
+
+data_slice transaction_view::slice(const range& value) const
+{
+    const auto start = begin_ + value.offset;
+    return{ start, start + value.size };
+}
+
+} // namespace chain
+} // namespace libbitcoin
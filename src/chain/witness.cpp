@@ -40,6 +40,7 @@
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/istream_reader.hpp>
 #include <bitcoin/bitcoin/utility/ostream_writer.hpp>
+#include <bitcoin/bitcoin/utility/sha256_writer.hpp>
 
 namespace libbitcoin {
 namespace chain {
@@ -142,8 +143,9 @@ witness witness::factory(reader& source, bool prefix)
 
 bool witness::from_data(const data_chunk& encoded, bool prefix)
 {
-    data_source istream(encoded);
-    return from_data(istream, prefix);
+    const auto begin = encoded.data();
+    auto source = make_safe_deserializer(begin, begin + encoded.size());
+    return from_data(source, prefix);
 }
 
 bool witness::from_data(std::istream& stream, bool prefix)
@@ -153,12 +155,14 @@ bool witness::from_data(std::istream& stream, bool prefix)
 }
 
 // Prefixed data assumed valid here though caller may confirm with is_valid.
-bool witness::from_data(reader& source, bool prefix)
+// private
+template <class Source>
+bool witness::deserialize(Source& source, bool prefix)
 {
     reset();
     valid_ = true;
 
-    const auto read_element = [](reader& source)
+    const auto read_element = [&source]()
     {
         // Tokens encoded as variable integer prefixed byte array (bip144).
         const auto size = source.read_size_little_endian();
@@ -181,12 +185,12 @@ bool witness::from_data(reader& source, bool prefix)
         // Witness prefix is an element count, not byte length (unlike script).
         // On wire each witness is prefixed with number of elements (bip144).
         for (auto count = source.read_size_little_endian(); count > 0; --count)
-             stack_.push_back(read_element(source));
+             stack_.push_back(read_element());
     }
     else
     {
         while (!source.is_exhausted())
-            stack_.push_back(read_element(source));
+            stack_.push_back(read_element());
     }
 
     if (!source)
@@ -195,6 +199,16 @@ bool witness::from_data(reader& source, bool prefix)
     return source;
 }
 
+bool witness::from_data(reader& source, bool prefix)
+{
+    return deserialize(source, prefix);
+}
+
+bool witness::from_data(byte_deserializer& source, bool prefix)
+{
+    return deserialize(source, prefix);
+}
+
 // private/static
 size_t witness::serialized_size(const data_stack& stack)
 {
@@ -227,13 +241,9 @@ bool witness::is_valid() const
 
 data_chunk witness::to_data(bool prefix) const
 {
-    data_chunk data;
-    const auto size = serialized_size(prefix);
-    data.reserve(size);
-    data_sink ostream(data);
-    to_data(ostream, prefix);
-    ostream.flush();
-    BITCOIN_ASSERT(data.size() == size);
+    data_chunk data(serialized_size(prefix));
+    auto sink = make_unsafe_serializer(data.data());
+    to_data(sink, prefix);
     return data;
 }
 
@@ -243,7 +253,9 @@ void witness::to_data(std::ostream& stream, bool prefix) const
     to_data(sink, prefix);
 }
 
-void witness::to_data(writer& sink, bool prefix) const
+// private
+template <class Sink>
+void witness::serialize(Sink& sink, bool prefix) const
 {
     // Witness prefix is an element count, not byte length (unlike script).
     if (prefix)
@@ -260,6 +272,16 @@ void witness::to_data(writer& sink, bool prefix) const
     std::for_each(stack_.begin(), stack_.end(), serialize);
 }
 
+void witness::to_data(writer& sink, bool prefix) const
+{
+    serialize(sink, prefix);
+}
+
+void witness::to_data(byte_serializer& sink, bool prefix) const
+{
+    serialize(sink, prefix);
+}
+
 std::string witness::to_string() const
 {
     if (!valid_)
@@ -452,8 +474,10 @@ bool witness::extract_embedded_script(script& out_script,
                     return false;
 
                 // SHA256 of the witness script must match program (bip141).
+                sha256_writer sink;
+                out_script.to_data(sink, false);
                 return std::equal(program.begin(), program.end(),
-                    sha256_hash(out_script.to_data(false)).begin());
+                    sink.sha256_hash().begin());
             }
 
             return false;
@@ -476,7 +500,8 @@ bool witness::extract_embedded_script(script& out_script,
 // The program script is either a prevout script or an emedded script.
 // It validates this witness, from which the witness script is derived.
 code witness::verify(const transaction& tx, uint32_t input_index,
-    uint32_t forks, const script& program_script, uint64_t value) const
+    uint32_t forks, const script& program_script, uint64_t value,
+    signature_queue* deferred, signature_cache* cache) const
 {
     const auto version = program_script.version();
 
@@ -492,7 +517,7 @@ code witness::verify(const transaction& tx, uint32_t input_index,
                 return error::invalid_witness;
 
             program witness(script, tx, input_index, forks, std::move(stack),
-                value, version);
+                value, version, deferred, cache);
 
             if ((ec = witness.evaluate()))
                 return ec;
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/machine/decoded_script.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/machine/opcode.hpp>
+#include <bitcoin/bitcoin/machine/operation.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+namespace machine {
+
+// The number of bytes that encode the size of data for the push code.
+inline size_t size_width(opcode code)
+{
+    switch (code)
+    {
+        case opcode::push_one_size:
+            return 1;
+        case opcode::push_two_size:
+            return 2;
+        case opcode::push_four_size:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+// Mirrors the parse of script bytes into operation::list.
+decoded_script::decoded_script(data_slice bytes)
+  : bytes_(bytes), valid_(true)
+{
+    BC_CONSTEXPR auto op_75 = static_cast<uint8_t>(opcode::push_size_75);
+
+    // One operation per byte is the upper limit of operations.
+    records_.reserve(bytes.size());
+
+    const auto begin = bytes.begin();
+    const auto end = bytes.end();
+    auto it = begin;
+
+    while (it != end)
+    {
+        const auto code = static_cast<opcode>(*it++);
+        const auto width = size_width(code);
+        uint64_t size;
+
+        if (width == 0)
+        {
+            const auto byte = static_cast<uint8_t>(code);
+            size = byte <= op_75 ? byte : 0;
+        }
+        else if (static_cast<size_t>(end - it) < width)
+        {
+            size = max_uint64;
+        }
+        else
+        {
+            size = width == 1 ? *it :
+                width == 2 ? from_little_endian_unsafe<uint16_t>(it) :
+                    from_little_endian_unsafe<uint32_t>(it);
+            it += width;
+        }
+
+        if (size > max_block_size || size > static_cast<size_t>(end - it))
+        {
+            valid_ = false;
+            records_.push_back({ invalid_code, 0, 0 });
+            break;
+        }
+
+        const auto offset = static_cast<uint32_t>(it - begin);
+        records_.push_back({ code, offset, static_cast<uint32_t>(size) });
+        it += size;
+    }
+
+    records_.shrink_to_fit();
+}
+
+bool decoded_script::is_valid() const
+{
+    return valid_;
+}
+
+bool decoded_script::empty() const
+{
+    return records_.empty();
+}
+
+size_t decoded_script::size() const
+{
+    return records_.size();
+}
+
+const decoded_script::list& decoded_script::records() const
+{
+    return records_;
+}
+
+opcode decoded_script::code(size_t index) const
+{
+    BITCOIN_ASSERT(index < records_.size());
+    return records_[index].code;
+}
+
+data_slice decoded_script::data(size_t index) const
+{
+    BITCOIN_ASSERT(index < records_.size());
+    const auto& record = records_[index];
+    const auto start = bytes_.begin() + record.offset;
+    return{ start, start + record.size };
+}
+
+// Count 1..16 multisig accurately for embedded (bip16) and witness (bip141).
+inline size_t multisig_sigops(bool accurate, opcode code)
+{
+    return accurate && operation::is_positive(code) ?
+        operation::opcode_to_positive(code) : multisig_default_sigops;
+}
+
+size_t decoded_script::sigops(bool accurate) const
+{
+    size_t total = 0;
+    auto preceding = opcode::push_negative_1;
+
+    for (const auto& record: records_)
+    {
+        const auto code = record.code;
+
+        if (code == opcode::checksig ||
+            code == opcode::checksigverify)
+        {
+            ++total;
+        }
+        else if (
+            code == opcode::checkmultisig ||
+            code == opcode::checkmultisigverify)
+        {
+            total += multisig_sigops(accurate, preceding);
+        }
+
+        preceding = code;
+    }
+
+    return total;
+}
+
+//*****************************************************************************
+// CONSENSUS: this pattern is used to activate bip16 validation rules.
+//*****************************************************************************
+bool decoded_script::is_pay_script_hash_pattern() const
+{
+    return records_.size() == 3
+        && records_[0].code == opcode::hash160
+        && records_[1].code == opcode::push_size_20
+        && records_[2].code == opcode::equal;
+}
+
+//*****************************************************************************
+// CONSENSUS: this pattern is used in bip141 validation rules.
+//*****************************************************************************
+bool decoded_script::is_witness_program_pattern() const
+{
+    return records_.size() == 2
+        && operation::is_version(records_[0].code)
+        && records_[1].size >= min_witness_program
+        && records_[1].size <= max_witness_program;
+}
+
+} // namespace machine
+} // namespace libbitcoin
@@ -55,6 +55,8 @@ program::program()
     input_index_(0),
     forks_(0),
     value_(0),
+    deferred_(nullptr),
+    cache_(nullptr),
     version_(script_version::unversioned),
     negative_count_(0),
     operation_count_(0),
@@ -69,6 +71,8 @@ program::program(const script& script)
     input_index_(0),
     forks_(0),
     value_(0),
+    deferred_(nullptr),
+    cache_(nullptr),
     version_(script_version::unversioned),
     negative_count_(0),
     operation_count_(0),
@@ -78,12 +82,15 @@ program::program(const script& script)
 }
 
 program::program(const script& script, const chain::transaction& transaction,
-    uint32_t input_index, uint32_t forks)
+    uint32_t input_index, uint32_t forks, signature_queue* deferred,
+    signature_cache* cache)
   : script_(script),
     transaction_(transaction),
     input_index_(input_index),
     forks_(forks),
     value_(max_uint64),
+    deferred_(deferred),
+    cache_(cache),
     version_(script_version::unversioned),
     negative_count_(0),
     operation_count_(0),
@@ -95,12 +102,14 @@ program::program(const script& script, const chain::transaction& transaction,
 // Condition, alternate, jump and operation_count are not copied.
 program::program(const script& script, const chain::transaction& transaction,
     uint32_t input_index, uint32_t forks, data_stack&& stack, uint64_t value,
-    script_version version)
+    script_version version, signature_queue* deferred, signature_cache* cache)
   : script_(script),
     transaction_(transaction),
     input_index_(input_index),
     forks_(forks),
     value_(value),
+    deferred_(deferred),
+    cache_(cache),
     version_(version),
     negative_count_(0),
     operation_count_(0),
@@ -118,6 +127,8 @@ program::program(const script& script, const program& other)
     input_index_(other.input_index_),
     forks_(other.forks_),
     value_(other.value_),
+    deferred_(other.deferred_),
+    cache_(other.cache_),
     version_(script_version::unversioned),
     negative_count_(0),
     operation_count_(0),
@@ -134,6 +145,8 @@ program::program(const script& script, program&& other, bool)
     input_index_(other.input_index_),
     forks_(other.forks_),
     value_(other.value_),
+    deferred_(other.deferred_),
+    cache_(other.cache_),
     version_(script_version::unversioned),
     negative_count_(0),
     operation_count_(0),
@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/machine/script_cache.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/random.hpp>
+#include <bitcoin/bitcoin/utility/sha256_writer.hpp>
+#include <bitcoin/bitcoin/utility/thread.hpp>
+
+namespace libbitcoin {
+namespace machine {
+
+// Stripes allow concurrent validation threads to rarely contend.
+static constexpr size_t stripes = 16;
+
+// Approximate memory of an entry, including set node, bucket and ring slot.
+static constexpr size_t entry_bytes = 128;
+
+const size_t script_cache::default_size = 16 * 1024 * 1024;
+
+static hash_digest new_salt()
+{
+    data_chunk salt(hash_size);
+    pseudo_random_fill(salt);
+    return to_array<hash_size>(salt);
+}
+
+size_t script_cache::key_hasher::operator()(const hash_digest& key) const
+{
+    return from_little_endian_unsafe<size_t>(key.begin());
+}
+
+script_cache::script_cache(size_t maximum_bytes)
+  : salt_(new_salt()),
+    stripe_capacity_(std::max(maximum_bytes / entry_bytes / stripes,
+        size_t(1))),
+    stripes_(stripes),
+    hits_(0),
+    misses_(0)
+{
+    for (auto& stripe: stripes_)
+        stripe.keys.reserve(stripe_capacity_);
+}
+
+hash_digest script_cache::to_key(const hash_digest& witness_hash,
+    uint32_t forks) const
+{
+    sha256_writer sink;
+    sink.write_hash(salt_);
+    sink.write_hash(witness_hash);
+    sink.write_4_bytes_little_endian(forks);
+    return sink.sha256_hash();
+}
+
+// The stripe is selected by key bytes not used by the set hasher.
+script_cache::stripe& script_cache::to_stripe(
+    const hash_digest& key) const
+{
+    return stripes_[key.back() % stripes];
+}
+
+bool script_cache::contains(const hash_digest& witness_hash,
+    uint32_t forks) const
+{
+    const auto key = to_key(witness_hash, forks);
+    auto& stripe = to_stripe(key);
+    bool found;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    {
+        shared_lock lock(stripe.mutex);
+        found = stripe.keys.find(key) != stripe.keys.end();
+    }
+    ///////////////////////////////////////////////////////////////////////////
+
+    ++(found ? hits_ : misses_);
+    return found;
+}
+
+void script_cache::store(const hash_digest& witness_hash, uint32_t forks)
+{
+    const auto key = to_key(witness_hash, forks);
+    auto& stripe = to_stripe(key);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    unique_lock lock(stripe.mutex);
+
+    if (!stripe.keys.insert(key).second)
+        return;
+
+    // Fill the ring, then evict the oldest entry on each insert.
+    if (stripe.ring.size() < stripe_capacity_)
+    {
+        stripe.ring.push_back(key);
+        return;
+    }
+
+    stripe.keys.erase(stripe.ring[stripe.next]);
+    stripe.ring[stripe.next] = key;
+    stripe.next = (stripe.next + 1) % stripe_capacity_;
+    ///////////////////////////////////////////////////////////////////////////
+}
+
+void script_cache::clear()
+{
+    for (auto& stripe: stripes_)
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        unique_lock lock(stripe.mutex);
+        stripe.keys.clear();
+        stripe.ring.clear();
+        stripe.next = 0;
+        ///////////////////////////////////////////////////////////////////////
+    }
+}
+
+size_t script_cache::capacity() const
+{
+    return stripe_capacity_ * stripes;
+}
+
+size_t script_cache::size() const
+{
+    size_t total = 0;
+
+    for (const auto& stripe: stripes_)
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        shared_lock lock(stripe.mutex);
+        total += stripe.keys.size();
+        ///////////////////////////////////////////////////////////////////////
+    }
+
+    return total;
+}
+
+size_t script_cache::hits() const
+{
+    return hits_;
+}
+
+size_t script_cache::misses() const
+{
+    return misses_;
+}
+
+} // namespace machine
+} // namespace libbitcoin
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/machine/signature_queue.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <bitcoin/bitcoin/machine/signature_cache.hpp>
+#include <bitcoin/bitcoin/math/elliptic_curve.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+
+namespace libbitcoin {
+namespace machine {
+
+signature_queue::signature_queue(signature_cache* cache)
+  : cache_(cache)
+{
+}
+
+void signature_queue::enqueue(data_chunk&& public_key,
+    const hash_digest& sighash, const ec_signature& signature)
+{
+    checks_.push_back({ std::move(public_key), sighash, signature });
+}
+
+bool signature_queue::empty() const
+{
+    return checks_.empty();
+}
+
+size_t signature_queue::size() const
+{
+    return checks_.size();
+}
+
+void signature_queue::clear()
+{
+    checks_.clear();
+}
+
+bool signature_queue::verify(size_t index) const
+{
+    BITCOIN_ASSERT(index < checks_.size());
+    const auto& check = checks_[index];
+
+    if (!verify_signature(check.public_key, check.sighash, check.signature))
+        return false;
+
+    if (cache_ != nullptr)
+        cache_->store(check.sighash, check.public_key, check.signature);
+
+    return true;
+}
+
+bool signature_queue::verify() const
+{
+    for (size_t index = 0; index < checks_.size(); ++index)
+        if (!verify(index))
+            return false;
+
+    return true;
+}
+
+} // namespace machine
+} // namespace libbitcoin
@@ -29,6 +29,13 @@
 #include <string.h>
 #include "zeroize.h"
 
+/* SHA-NI and AVX2 are used when detected at runtime (gcc/clang on x86). */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHA256_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 static uint32_t be32dec(const void* pp)
 {
     const uint8_t* p = (uint8_t const*)pp;
@@ -95,9 +102,36 @@ static unsigned char PAD[SHA256_BLOCK_LENGTH] =
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
+static const uint32_t SHA256IV[SHA256_STATE_LENGTH] =
+{
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+/* Padding (after the message) of a 64 byte message. */
+static const uint8_t PAD64[SHA256_BLOCK_LENGTH] =
+{
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0x00
+};
+
+/* Padding (after the message) of a 32 byte message. */
+static const uint8_t PAD32[SHA256_DIGEST_LENGTH] =
+{
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x00
+};
+
+typedef void (*SHA256TransformFunction)(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t block[SHA256_BLOCK_LENGTH]);
+
 void SHA256Pad(SHA256CTX* context);
 void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
     const uint8_t block[SHA256_BLOCK_LENGTH]);
+static void SHA256TransformPortable(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t block[SHA256_BLOCK_LENGTH]);
 
 void SHA256_(const uint8_t* input, size_t length,
     uint8_t digest[SHA256_DIGEST_LENGTH])
@@ -182,7 +216,7 @@ void SHA256Pad(SHA256CTX* context)
     SHA256Update(context, len, 8);
 }
 
-void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
+static void SHA256TransformPortable(uint32_t state[SHA256_STATE_LENGTH],
     const uint8_t block[SHA256_BLOCK_LENGTH])
 {
     int i;
@@ -274,3 +308,371 @@ void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
     zeroize((void*)&t0, sizeof t0);
     zeroize((void*)&t1, sizeof t1);
 }
+
+#ifdef SHA256_X86
+
+static const uint32_t K256[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/* Four rounds, message words (with constants) in the low then high half. */
+#define QUAD(n, msg) \
+    tmp = _mm_add_epi32(msg, \
+        _mm_loadu_si128((const __m128i*)&K256[4 * (n)])); \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, tmp); \
+    tmp = _mm_shuffle_epi32(tmp, 0x0e); \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, tmp)
+
+/* Message schedule, next += W[t-7] (from cur/prev) then sigma1 of cur. */
+#define SCHEDULE2(next, cur, prev) \
+    next = _mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4)); \
+    next = _mm_sha256msg2_epu32(next, cur)
+
+/* Message schedule, prev += sigma0 (from prev/cur). */
+#define SCHEDULE1(prev, cur) \
+    prev = _mm_sha256msg1_epu32(prev, cur)
+
+__attribute__((target("sha,sse4.1")))
+static void SHA256TransformShani(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t block[SHA256_BLOCK_LENGTH])
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+        0x0405060700010203ULL);
+
+    __m128i state0, state1, save0, save1, tmp;
+    __m128i msg0, msg1, msg2, msg3;
+
+    /* Reorder the state from ABCD/EFGH into ABEF/CDGH. */
+    tmp = _mm_loadu_si128((const __m128i*)&state[0]);
+    state1 = _mm_loadu_si128((const __m128i*)&state[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xb1);
+    state1 = _mm_shuffle_epi32(state1, 0x1b);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+    save0 = state0;
+    save1 = state1;
+
+    /* Big endian message words. */
+    msg0 = _mm_shuffle_epi8(
+        _mm_loadu_si128((const __m128i*)(block + 0)), mask);
+    msg1 = _mm_shuffle_epi8(
+        _mm_loadu_si128((const __m128i*)(block + 16)), mask);
+    msg2 = _mm_shuffle_epi8(
+        _mm_loadu_si128((const __m128i*)(block + 32)), mask);
+    msg3 = _mm_shuffle_epi8(
+        _mm_loadu_si128((const __m128i*)(block + 48)), mask);
+
+    QUAD(0, msg0);
+    QUAD(1, msg1);
+    SCHEDULE1(msg0, msg1);
+    QUAD(2, msg2);
+    SCHEDULE1(msg1, msg2);
+
+    QUAD(3, msg3);
+    SCHEDULE2(msg0, msg3, msg2);
+    SCHEDULE1(msg2, msg3);
+    QUAD(4, msg0);
+    SCHEDULE2(msg1, msg0, msg3);
+    SCHEDULE1(msg3, msg0);
+    QUAD(5, msg1);
+    SCHEDULE2(msg2, msg1, msg0);
+    SCHEDULE1(msg0, msg1);
+    QUAD(6, msg2);
+    SCHEDULE2(msg3, msg2, msg1);
+    SCHEDULE1(msg1, msg2);
+
+    QUAD(7, msg3);
+    SCHEDULE2(msg0, msg3, msg2);
+    SCHEDULE1(msg2, msg3);
+    QUAD(8, msg0);
+    SCHEDULE2(msg1, msg0, msg3);
+    SCHEDULE1(msg3, msg0);
+    QUAD(9, msg1);
+    SCHEDULE2(msg2, msg1, msg0);
+    SCHEDULE1(msg0, msg1);
+    QUAD(10, msg2);
+    SCHEDULE2(msg3, msg2, msg1);
+    SCHEDULE1(msg1, msg2);
+
+    QUAD(11, msg3);
+    SCHEDULE2(msg0, msg3, msg2);
+    SCHEDULE1(msg2, msg3);
+    QUAD(12, msg0);
+    SCHEDULE2(msg1, msg0, msg3);
+    SCHEDULE1(msg3, msg0);
+    QUAD(13, msg1);
+    SCHEDULE2(msg2, msg1, msg0);
+    QUAD(14, msg2);
+    SCHEDULE2(msg3, msg2, msg1);
+    QUAD(15, msg3);
+
+    state0 = _mm_add_epi32(state0, save0);
+    state1 = _mm_add_epi32(state1, save1);
+
+    /* Reorder the state from ABEF/CDGH back into ABCD/EFGH. */
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    _mm_storeu_si128((__m128i*)&state[0], state0);
+    _mm_storeu_si128((__m128i*)&state[4], state1);
+}
+
+#undef QUAD
+#undef SCHEDULE2
+#undef SCHEDULE1
+
+static int SHA256HasShani(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    /* SSSE3 (ecx:9) and SSE4.1 (ecx:19) are required for the shuffles. */
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) ||
+        !(ecx & (1u << 9)) || !(ecx & (1u << 19)))
+        return 0;
+
+    /* SHA extensions (leaf 7, ebx:29). */
+    if (__get_cpuid_max(0, NULL) < 7)
+        return 0;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & (1u << 29)) != 0;
+}
+
+static int SHA256HasAvx2(void)
+{
+    unsigned int eax, ebx, ecx, edx, xcr0;
+
+    /* OSXSAVE (ecx:27) is required to query enabled register state. */
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & (1u << 27)))
+        return 0;
+
+    /* The OS must preserve the xmm and ymm registers (xcr0:1-2). */
+    __asm__ ("xgetbv" : "=a" (xcr0), "=d" (edx) : "c" (0));
+    if ((xcr0 & 6u) != 6u)
+        return 0;
+
+    /* AVX2 (leaf 7, ebx:5). */
+    if (__get_cpuid_max(0, NULL) < 7)
+        return 0;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & (1u << 5)) != 0;
+}
+
+#define ADD(x, y)      _mm256_add_epi32(x, y)
+#define XOR(x, y)      _mm256_xor_si256(x, y)
+#define AND(x, y)      _mm256_and_si256(x, y)
+#define OR(x, y)       _mm256_or_si256(x, y)
+#define SHR8(x, n)     _mm256_srli_epi32(x, n)
+#define ROTR8(x, n)    OR(SHR8(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define Ch8(x, y, z)   XOR(AND(x, XOR(y, z)), z)
+#define Maj8(x, y, z)  OR(AND(x, OR(y, z)), AND(y, z))
+#define S08(x)         XOR(XOR(ROTR8(x, 2), ROTR8(x, 13)), ROTR8(x, 22))
+#define S18(x)         XOR(XOR(ROTR8(x, 6), ROTR8(x, 11)), ROTR8(x, 25))
+#define s08(x)         XOR(XOR(ROTR8(x, 7), ROTR8(x, 18)), SHR8(x, 3))
+#define s18(x)         XOR(XOR(ROTR8(x, 17), ROTR8(x, 19)), SHR8(x, 10))
+
+/* Eight independent transforms, one per 32 bit lane (message consumed). */
+__attribute__((target("avx2")))
+static void SHA256Transform8(__m256i state[SHA256_STATE_LENGTH],
+    __m256i W[16])
+{
+    int i;
+    __m256i t0, t1;
+    __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+    __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (i = 0; i < 64; i++)
+    {
+        if (i >= 16)
+        {
+            W[i & 15] = ADD(ADD(W[i & 15], s18(W[(i - 2) & 15])),
+                ADD(W[(i - 7) & 15], s08(W[(i - 15) & 15])));
+        }
+
+        t0 = ADD(ADD(h, S18(e)), ADD(Ch8(e, f, g),
+            ADD(_mm256_set1_epi32((int)K256[i]), W[i & 15])));
+        t1 = ADD(S08(a), Maj8(a, b, c));
+        h = g;
+        g = f;
+        f = e;
+        e = ADD(d, t0);
+        d = c;
+        c = b;
+        b = a;
+        a = ADD(t0, t1);
+    }
+
+    state[0] = ADD(state[0], a);
+    state[1] = ADD(state[1], b);
+    state[2] = ADD(state[2], c);
+    state[3] = ADD(state[3], d);
+    state[4] = ADD(state[4], e);
+    state[5] = ADD(state[5], f);
+    state[6] = ADD(state[6], g);
+    state[7] = ADD(state[7], h);
+}
+
+/* Double hash of eight consecutive 64 byte inputs (output may alias). */
+__attribute__((target("avx2")))
+static void SHA256Double64Avx2(const uint8_t* input, uint8_t* output)
+{
+    int i, lane;
+    __m256i state[SHA256_STATE_LENGTH];
+    __m256i W[16];
+    uint32_t words[8];
+
+    for (i = 0; i < 8; i++)
+        state[i] = _mm256_set1_epi32((int)SHA256IV[i]);
+
+    /* Transpose the inputs into lanes, all input is read here. */
+    for (i = 0; i < 16; i++)
+    {
+        for (lane = 0; lane < 8; lane++)
+            words[lane] = be32dec(input + lane * 64 + i * 4);
+
+        W[i] = _mm256_loadu_si256((const __m256i*)words);
+    }
+
+    SHA256Transform8(state, W);
+
+    /* Padding block of a 64 byte message. */
+    W[0] = _mm256_set1_epi32((int)0x80000000u);
+    for (i = 1; i < 15; i++)
+        W[i] = _mm256_setzero_si256();
+    W[15] = _mm256_set1_epi32(512);
+
+    SHA256Transform8(state, W);
+
+    /* The 32 byte digest with its padding is the second message. */
+    for (i = 0; i < 8; i++)
+    {
+        W[i] = state[i];
+        state[i] = _mm256_set1_epi32((int)SHA256IV[i]);
+    }
+
+    W[8] = _mm256_set1_epi32((int)0x80000000u);
+    for (i = 9; i < 15; i++)
+        W[i] = _mm256_setzero_si256();
+    W[15] = _mm256_set1_epi32(256);
+
+    SHA256Transform8(state, W);
+
+    /* Transpose the lanes into the outputs. */
+    for (i = 0; i < 8; i++)
+    {
+        _mm256_storeu_si256((__m256i*)words, state[i]);
+
+        for (lane = 0; lane < 8; lane++)
+            be32enc(output + lane * 32 + i * 4, words[lane]);
+    }
+}
+
+#undef ADD
+#undef XOR
+#undef AND
+#undef OR
+#undef SHR8
+#undef ROTR8
+#undef Ch8
+#undef Maj8
+#undef S08
+#undef S18
+#undef s08
+#undef s18
+
+#endif /* SHA256_X86 */
+
+static SHA256TransformFunction SHA256Select(void)
+{
+#ifdef SHA256_X86
+    if (SHA256HasShani())
+        return SHA256TransformShani;
+#endif
+
+    return SHA256TransformPortable;
+}
+
+/* Selection is idempotent, so concurrent first calls store the same value. */
+static SHA256TransformFunction SHA256Selected = NULL;
+
+void SHA256Transform(uint32_t state[SHA256_STATE_LENGTH],
+    const uint8_t block[SHA256_BLOCK_LENGTH])
+{
+    if (SHA256Selected == NULL)
+        SHA256Selected = SHA256Select();
+
+    SHA256Selected(state, block);
+}
+
+/* Double hash of one 64 byte input (output may alias). */
+static void SHA256Double64One(const uint8_t* input, uint8_t* output)
+{
+    uint32_t state[SHA256_STATE_LENGTH];
+    uint8_t block[SHA256_BLOCK_LENGTH];
+
+    memcpy(state, SHA256IV, sizeof state);
+    SHA256Transform(state, input);
+    SHA256Transform(state, PAD64);
+
+    be32enc_vect(block, state, SHA256_DIGEST_LENGTH);
+    memcpy(block + SHA256_DIGEST_LENGTH, PAD32, sizeof PAD32);
+
+    memcpy(state, SHA256IV, sizeof state);
+    SHA256Transform(state, block);
+    be32enc_vect(output, state, SHA256_DIGEST_LENGTH);
+}
+
+/* A single SHA-NI stream outpaces eight AVX2 lanes, so lanes are used only
+   in its absence. Selection is idempotent, as with the transform. */
+static int SHA256Lanes = -1;
+
+void SHA256Double64(const uint8_t* input, uint8_t* output, size_t blocks)
+{
+    if (SHA256Lanes < 0)
+    {
+#ifdef SHA256_X86
+        SHA256Lanes = !SHA256HasShani() && SHA256HasAvx2() ? 8 : 1;
+#else
+        SHA256Lanes = 1;
+#endif
+    }
+
+#ifdef SHA256_X86
+    if (SHA256Lanes == 8)
+    {
+        for (; blocks >= 8; blocks -= 8)
+        {
+            SHA256Double64Avx2(input, output);
+            input += 8 * SHA256_BLOCK_LENGTH;
+            output += 8 * SHA256_DIGEST_LENGTH;
+        }
+    }
+#endif
+
+    for (; blocks > 0; blocks--)
+    {
+        SHA256Double64One(input, output);
+        input += SHA256_BLOCK_LENGTH;
+        output += SHA256_DIGEST_LENGTH;
+    }
+}
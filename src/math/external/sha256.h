@@ -53,6 +53,10 @@ void SHA256Init(SHA256CTX* context);
 void SHA256Update(SHA256CTX* context, const uint8_t* input, size_t length);
 void SHA256Final(SHA256CTX* context, uint8_t digest[SHA256_DIGEST_LENGTH]);
 
+/* Double hash each of blocks consecutive 64 byte inputs into consecutive 32
+   byte outputs. The output may alias the input (in place reduction). */
+void SHA256Double64(const uint8_t* input, uint8_t* output, size_t blocks);
+
 #ifdef __cplusplus
 }
 #endif
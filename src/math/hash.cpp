@@ -24,6 +24,7 @@
 #include <errno.h>
 #include <new>
 #include <stdexcept>
+#include <bitcoin/bitcoin/utility/assert.hpp>
 #include "../math/external/crypto_scrypt.h"
 #include "../math/external/hmac_sha256.h"
 #include "../math/external/hmac_sha512.h"
@@ -40,6 +41,41 @@ hash_digest bitcoin_hash(data_slice data)
     return sha256_hash(sha256_hash(data));
 }
 
+void bitcoin_hash_pairs(hash_list& out, const hash_list& in)
+{
+    BITCOIN_ASSERT(in.size() % 2 == 0);
+    const auto pairs = in.size() / 2;
+
+    // Hashes are contiguous arrays, so each pair is a 64 byte block.
+    static_assert(sizeof(hash_digest) == hash_size, "unpacked hash");
+
+    if (pairs == 0)
+    {
+        out.clear();
+        return;
+    }
+
+    if (&out == &in)
+    {
+        SHA256Double64(in.front().data(), out.front().data(), pairs);
+        out.resize(pairs);
+        return;
+    }
+
+    out.resize(pairs);
+    SHA256Double64(in.front().data(), out.front().data(), pairs);
+}
+
+hash_digest bitcoin_hash(const hash_digest& left, const hash_digest& right)
+{
+    hash_digest hash;
+    uint8_t block[2 * hash_size];
+    std::copy(left.begin(), left.end(), block);
+    std::copy(right.begin(), right.end(), block + hash_size);
+    SHA256Double64(block, hash.data(), 1);
+    return hash;
+}
+
 short_hash bitcoin_short_hash(data_slice data)
 {
     return ripemd160_hash(sha256_hash(data));
@@ -28,6 +28,7 @@
 #include <bitcoin/bitcoin/utility/binary.hpp>
 #include <bitcoin/bitcoin/utility/data.hpp>
 #include <bitcoin/bitcoin/utility/endian.hpp>
+#include <bitcoin/bitcoin/utility/sha256_writer.hpp>
 
 namespace libbitcoin {
 
@@ -52,7 +53,9 @@ bool to_stealth_prefix(uint32_t& out_prefix, const script& script)
     // A stealth filter is a leftmost substring of the stealth prefix.
     ////constexpr size_t size = binary::bits_per_block * sizeof(uint32_t);
 
-    const auto script_hash = bitcoin_hash(script.to_data(false));
+    sha256_writer sink;
+    script.to_data(sink, false);
+    const auto script_hash = sink.bitcoin_hash();
     out_prefix = from_little_endian_unsafe<uint32_t>(script_hash.begin());
     return true;
 }
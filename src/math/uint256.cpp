@@ -0,0 +1,456 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/math/uint256.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/utility/data.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+
+namespace libbitcoin {
+
+static BC_CONSTEXPR size_t word_bytes = sizeof(uint32_t);
+static BC_CONSTEXPR uint32_t decimal_chunk = 1000000000;
+static BC_CONSTEXPR size_t decimal_chunk_digits = 9;
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+uint256_t::uint256_t(const byte_array<32>& hash)
+{
+    auto it = hash.begin();
+
+    for (auto& word: words_)
+    {
+        word = from_little_endian_unsafe<uint32_t>(it);
+        it += word_bytes;
+    }
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+byte_array<32> uint256_t::hash() const
+{
+    byte_array<32> out;
+    auto it = out.begin();
+
+    for (const auto word: words_)
+    {
+        const auto bytes = to_little_endian(word);
+        it = std::copy(bytes.begin(), bytes.end(), it);
+    }
+
+    return out;
+}
+
+size_t uint256_t::bit_length() const
+{
+    for (auto index = word_count; index > 0; --index)
+    {
+        auto word = words_[index - 1];
+
+        if (word == 0)
+            continue;
+
+        size_t bits = 0;
+        for (; word != 0; word >>= 1)
+            ++bits;
+
+        return (index - 1) * word_bits + bits;
+    }
+
+    return 0;
+}
+
+size_t uint256_t::byte_length() const
+{
+    return (bit_length() + byte_bits - 1) / byte_bits;
+}
+
+uint64_t uint256_t::operator[](size_t index) const
+{
+    const auto low = 2 * index;
+
+    if (low >= word_count)
+        return 0;
+
+    return (static_cast<uint64_t>(words_[low + 1]) << word_bits) | words_[low];
+}
+
+uint256_t::operator uint64_t() const
+{
+    return (*this)[0];
+}
+
+// Unary operators.
+//-----------------------------------------------------------------------------
+
+uint256_t uint256_t::operator~() const
+{
+    uint256_t out;
+
+    for (size_t index = 0; index < word_count; ++index)
+        out.words_[index] = ~words_[index];
+
+    return out;
+}
+
+uint256_t uint256_t::operator-() const
+{
+    auto out = ~(*this);
+    return ++out;
+}
+
+uint256_t& uint256_t::operator++()
+{
+    // Carry until a word does not wrap to zero.
+    for (auto& word: words_)
+        if (++word != 0)
+            break;
+
+    return *this;
+}
+
+// Assignment operators.
+//-----------------------------------------------------------------------------
+
+uint256_t& uint256_t::operator<<=(uint32_t shift)
+{
+    const size_t words = shift / word_bits;
+    const size_t bits = shift % word_bits;
+
+    if (words >= word_count)
+    {
+        words_.fill(0);
+        return *this;
+    }
+
+    for (auto index = word_count; index > 0; --index)
+    {
+        const auto target = index - 1;
+        uint32_t word = 0;
+
+        if (target >= words)
+        {
+            const auto source = target - words;
+            word = words_[source] << bits;
+
+            if (bits != 0 && source > 0)
+                word |= words_[source - 1] >> (word_bits - bits);
+        }
+
+        words_[target] = word;
+    }
+
+    return *this;
+}
+
+uint256_t& uint256_t::operator>>=(uint32_t shift)
+{
+    const size_t words = shift / word_bits;
+    const size_t bits = shift % word_bits;
+
+    if (words >= word_count)
+    {
+        words_.fill(0);
+        return *this;
+    }
+
+    for (size_t target = 0; target < word_count; ++target)
+    {
+        const auto source = target + words;
+        uint32_t word = 0;
+
+        if (source < word_count)
+        {
+            word = words_[source] >> bits;
+
+            if (bits != 0 && source + 1 < word_count)
+                word |= words_[source + 1] << (word_bits - bits);
+        }
+
+        words_[target] = word;
+    }
+
+    return *this;
+}
+
+uint256_t& uint256_t::operator+=(const uint256_t& other)
+{
+    uint64_t carry = 0;
+
+    for (size_t index = 0; index < word_count; ++index)
+    {
+        carry += static_cast<uint64_t>(words_[index]) + other.words_[index];
+        words_[index] = static_cast<uint32_t>(carry);
+        carry >>= word_bits;
+    }
+
+    return *this;
+}
+
+uint256_t& uint256_t::operator-=(const uint256_t& other)
+{
+    return *this += -other;
+}
+
+uint256_t& uint256_t::operator*=(uint32_t value)
+{
+    uint64_t carry = 0;
+
+    for (auto& word: words_)
+    {
+        carry += static_cast<uint64_t>(word) * value;
+        word = static_cast<uint32_t>(carry);
+        carry >>= word_bits;
+    }
+
+    return *this;
+}
+
+uint256_t& uint256_t::operator*=(const uint256_t& other)
+{
+    uint256_t product;
+
+    // Schoolbook multiplication, truncated to 256 bits.
+    for (size_t right = 0; right < word_count; ++right)
+    {
+        if (other.words_[right] == 0)
+            continue;
+
+        uint64_t carry = 0;
+
+        for (size_t left = 0; left + right < word_count; ++left)
+        {
+            auto& word = product.words_[left + right];
+            carry += word +
+                static_cast<uint64_t>(words_[left]) * other.words_[right];
+            word = static_cast<uint32_t>(carry);
+            carry >>= word_bits;
+        }
+    }
+
+    *this = product;
+    return *this;
+}
+
+uint256_t& uint256_t::operator/=(uint32_t value)
+{
+    if (value == 0)
+        throw std::overflow_error("uint256_t division by zero");
+
+    divide(value);
+    return *this;
+}
+
+uint256_t& uint256_t::operator/=(const uint256_t& other)
+{
+    const auto divisor_bits = other.bit_length();
+
+    if (divisor_bits == 0)
+        throw std::overflow_error("uint256_t division by zero");
+
+    // Single word divisors do not require shift and subtract.
+    if (divisor_bits <= word_bits)
+        return *this /= other.words_[0];
+
+    const auto dividend_bits = bit_length();
+
+    if (divisor_bits > dividend_bits)
+    {
+        words_.fill(0);
+        return *this;
+    }
+
+    // Only iterate over the bit positions in which the quotient may be set.
+    auto shift = dividend_bits - divisor_bits;
+    auto remainder = *this;
+    auto divisor = other << static_cast<uint32_t>(shift);
+    words_.fill(0);
+
+    while (true)
+    {
+        if (remainder >= divisor)
+        {
+            remainder -= divisor;
+            words_[shift / word_bits] |= uint32_t(1) << (shift % word_bits);
+        }
+
+        if (shift-- == 0)
+            break;
+
+        divisor >>= 1;
+    }
+
+    return *this;
+}
+
+// Comparison.
+//-----------------------------------------------------------------------------
+
+int uint256_t::compare(const uint256_t& other) const
+{
+    for (auto index = word_count; index > 0; --index)
+    {
+        const auto left = words_[index - 1];
+        const auto right = other.words_[index - 1];
+
+        if (left != right)
+            return left < right ? -1 : 1;
+    }
+
+    return 0;
+}
+
+std::string uint256_t::to_string() const
+{
+    auto value = *this;
+    std::vector<uint32_t> chunks;
+
+    // Extract nine decimal digits per division, least significant first.
+    do
+    {
+        chunks.push_back(value.divide(decimal_chunk));
+    } while (value != 0);
+
+    auto chunk = chunks.rbegin();
+    auto out = std::to_string(*chunk);
+
+    // Chunks other than the most significant are zero padded.
+    for (++chunk; chunk != chunks.rend(); ++chunk)
+    {
+        const auto digits = std::to_string(*chunk);
+        out.append(decimal_chunk_digits - digits.size(), '0');
+        out.append(digits);
+    }
+
+    return out;
+}
+
+// private
+uint32_t uint256_t::divide(uint32_t value)
+{
+    uint64_t remainder = 0;
+
+    for (auto index = word_count; index > 0; --index)
+    {
+        auto& word = words_[index - 1];
+        remainder = (remainder << word_bits) | word;
+        word = static_cast<uint32_t>(remainder / value);
+        remainder %= value;
+    }
+
+    return static_cast<uint32_t>(remainder);
+}
+
+// Free operators.
+//-----------------------------------------------------------------------------
+
+bool operator==(const uint256_t& left, const uint256_t& right)
+{
+    return left.compare(right) == 0;
+}
+
+bool operator!=(const uint256_t& left, const uint256_t& right)
+{
+    return left.compare(right) != 0;
+}
+
+bool operator<(const uint256_t& left, const uint256_t& right)
+{
+    return left.compare(right) < 0;
+}
+
+bool operator>(const uint256_t& left, const uint256_t& right)
+{
+    return left.compare(right) > 0;
+}
+
+bool operator<=(const uint256_t& left, const uint256_t& right)
+{
+    return left.compare(right) <= 0;
+}
+
+bool operator>=(const uint256_t& left, const uint256_t& right)
+{
+    return left.compare(right) >= 0;
+}
+
+uint256_t operator<<(const uint256_t& left, uint32_t shift)
+{
+    auto out = left;
+    return out <<= shift;
+}
+
+uint256_t operator>>(const uint256_t& left, uint32_t shift)
+{
+    auto out = left;
+    return out >>= shift;
+}
+
+uint256_t operator+(const uint256_t& left, const uint256_t& right)
+{
+    auto out = left;
+    return out += right;
+}
+
+uint256_t operator-(const uint256_t& left, const uint256_t& right)
+{
+    auto out = left;
+    return out -= right;
+}
+
+uint256_t operator*(const uint256_t& left, uint32_t right)
+{
+    auto out = left;
+    return out *= right;
+}
+
+uint256_t operator*(const uint256_t& left, const uint256_t& right)
+{
+    auto out = left;
+    return out *= right;
+}
+
+uint256_t operator/(const uint256_t& left, uint32_t right)
+{
+    auto out = left;
+    return out /= right;
+}
+
+uint256_t operator/(const uint256_t& left, const uint256_t& right)
+{
+    auto out = left;
+    return out /= right;
+}
+
+std::ostream& operator<<(std::ostream& output, const uint256_t& value)
+{
+    output << value.to_string();
+    return output;
+}
+
+} // namespace libbitcoin
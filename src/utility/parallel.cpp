@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <bitcoin/bitcoin/utility/threadpool.hpp>
+
+namespace libbitcoin {
+
+// State is shared with posted jobs, which may outlive the call if the pool
+// does not get to them before the calling thread completes all batches.
+struct parallel_state
+{
+    parallel_state(size_t count, size_t batch, parallel_handler&& handler)
+      : count(count), batch(batch), handler(std::move(handler)), cursor(0),
+        failure(count), completed(0)
+    {
+    }
+
+    const size_t count;
+    const size_t batch;
+    const parallel_handler handler;
+
+    std::atomic<size_t> cursor;
+    std::atomic<size_t> failure;
+
+    // These are protected by mutex.
+    size_t completed;
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+typedef std::shared_ptr<parallel_state> parallel_state_ptr;
+
+// Lower the failure index to the given index if not already lower.
+static void set_failure(parallel_state& state, size_t index)
+{
+    auto current = state.failure.load();
+
+    while (index < current &&
+        !state.failure.compare_exchange_weak(current, index));
+}
+
+// Claim and process batches until none remain.
+static void process(parallel_state_ptr state)
+{
+    while (true)
+    {
+        const auto first = state->cursor.fetch_add(state->batch);
+
+        if (first >= state->count)
+            return;
+
+        const auto last = std::min(first + state->batch, state->count);
+
+        // Indexes above a known failure cannot change the result, skip them.
+        for (auto index = first; index < last; ++index)
+        {
+            if (index > state->failure.load())
+                break;
+
+            if (!state->handler(index))
+            {
+                set_failure(*state, index);
+                break;
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Critical Section
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->completed += last - first;
+
+        if (state->completed == state->count)
+            state->done.notify_all();
+        ///////////////////////////////////////////////////////////////////////
+    }
+}
+
+size_t parallel_for(threadpool& pool, size_t count, size_t batch,
+    parallel_handler handler)
+{
+    if (count == 0)
+        return count;
+
+    batch = std::max(batch, size_t(1));
+    const auto batches = (count + batch - 1) / batch;
+    const auto jobs = std::min(pool.size(), batches - 1);
+    auto state = std::make_shared<parallel_state>(count, batch,
+        std::move(handler));
+
+    for (size_t job = 0; job < jobs; ++job)
+        pool.service().post(std::bind(process, state));
+
+    // The calling thread participates, guaranteeing progress.
+    process(state);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Critical Section
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state]()
+    {
+        return state->completed == state->count;
+    });
+    ///////////////////////////////////////////////////////////////////////////
+
+    return state->failure.load();
+}
+
+} // namespace libbitcoin
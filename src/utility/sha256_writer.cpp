@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/bitcoin/utility/sha256_writer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bitcoin/bitcoin/constants.hpp>
+#include <bitcoin/bitcoin/math/hash.hpp>
+#include <bitcoin/bitcoin/math/limits.hpp>
+#include <bitcoin/bitcoin/utility/assert.hpp>
+#include <bitcoin/bitcoin/utility/endian.hpp>
+#include "../math/external/sha256.h"
+
+namespace libbitcoin {
+
+sha256_writer::sha256_writer()
+  : valid_(true)
+{
+    static_assert(sizeof(context) == sizeof(SHA256CTX), "context mismatch");
+    SHA256Init(reinterpret_cast<SHA256CTX*>(&context_));
+}
+
+hash_digest sha256_writer::sha256_hash()
+{
+    BITCOIN_ASSERT_MSG(valid_, "sha256 writer is finalized");
+
+    hash_digest hash;
+    SHA256Final(reinterpret_cast<SHA256CTX*>(&context_), hash.data());
+    valid_ = false;
+    return hash;
+}
+
+hash_digest sha256_writer::bitcoin_hash()
+{
+    auto hash = sha256_hash();
+    SHA256_(hash.data(), hash.size(), hash.data());
+    return hash;
+}
+
+// Context.
+//-----------------------------------------------------------------------------
+
+sha256_writer::operator bool() const
+{
+    return valid_;
+}
+
+bool sha256_writer::operator!() const
+{
+    return !valid_;
+}
+
+// Hashes.
+//-----------------------------------------------------------------------------
+
+void sha256_writer::write_hash(const hash_digest& value)
+{
+    write_bytes(value.data(), value.size());
+}
+
+void sha256_writer::write_short_hash(const short_hash& value)
+{
+    write_bytes(value.data(), value.size());
+}
+
+void sha256_writer::write_mini_hash(const mini_hash& value)
+{
+    write_bytes(value.data(), value.size());
+}
+
+// Big Endian Integers.
+//-----------------------------------------------------------------------------
+
+void sha256_writer::write_2_bytes_big_endian(uint16_t value)
+{
+    const auto bytes = to_big_endian(value);
+    write_bytes(bytes.data(), bytes.size());
+}
+
+void sha256_writer::write_4_bytes_big_endian(uint32_t value)
+{
+    const auto bytes = to_big_endian(value);
+    write_bytes(bytes.data(), bytes.size());
+}
+
+void sha256_writer::write_8_bytes_big_endian(uint64_t value)
+{
+    const auto bytes = to_big_endian(value);
+    write_bytes(bytes.data(), bytes.size());
+}
+
+void sha256_writer::write_variable_big_endian(uint64_t value)
+{
+    if (value < varint_two_bytes)
+    {
+        write_byte(static_cast<uint8_t>(value));
+    }
+    else if (value <= max_uint16)
+    {
+        write_byte(varint_two_bytes);
+        write_2_bytes_big_endian(static_cast<uint16_t>(value));
+    }
+    else if (value <= max_uint32)
+    {
+        write_byte(varint_four_bytes);
+        write_4_bytes_big_endian(static_cast<uint32_t>(value));
+    }
+    else
+    {
+        write_byte(varint_eight_bytes);
+        write_8_bytes_big_endian(value);
+    }
+}
+
+void sha256_writer::write_size_big_endian(size_t value)
+{
+    write_variable_big_endian(value);
+}
+
+// Little Endian Integers.
+//-----------------------------------------------------------------------------
+
+void sha256_writer::write_2_bytes_little_endian(uint16_t value)
+{
+    const auto bytes = to_little_endian(value);
+    write_bytes(bytes.data(), bytes.size());
+}
+
+void sha256_writer::write_4_bytes_little_endian(uint32_t value)
+{
+    const auto bytes = to_little_endian(value);
+    write_bytes(bytes.data(), bytes.size());
+}
+
+void sha256_writer::write_8_bytes_little_endian(uint64_t value)
+{
+    const auto bytes = to_little_endian(value);
+    write_bytes(bytes.data(), bytes.size());
+}
+
+void sha256_writer::write_variable_little_endian(uint64_t value)
+{
+    if (value < varint_two_bytes)
+    {
+        write_byte(static_cast<uint8_t>(value));
+    }
+    else if (value <= max_uint16)
+    {
+        write_byte(varint_two_bytes);
+        write_2_bytes_little_endian(static_cast<uint16_t>(value));
+    }
+    else if (value <= max_uint32)
+    {
+        write_byte(varint_four_bytes);
+        write_4_bytes_little_endian(static_cast<uint32_t>(value));
+    }
+    else
+    {
+        write_byte(varint_eight_bytes);
+        write_8_bytes_little_endian(value);
+    }
+}
+
+void sha256_writer::write_size_little_endian(size_t value)
+{
+    write_variable_little_endian(value);
+}
+
+// Bytes.
+//-----------------------------------------------------------------------------
+
+void sha256_writer::write_byte(uint8_t value)
+{
+    write_bytes(&value, 1);
+}
+
+void sha256_writer::write_bytes(const data_chunk& data)
+{
+    write_bytes(data.data(), data.size());
+}
+
+void sha256_writer::write_bytes(const uint8_t* data, size_t size)
+{
+    BITCOIN_ASSERT_MSG(valid_, "sha256 writer is finalized");
+    SHA256Update(reinterpret_cast<SHA256CTX*>(&context_), data, size);
+}
+
+void sha256_writer::write_string(const std::string& value, size_t size)
+{
+    const auto length = std::min(size, value.size());
+    write_bytes(reinterpret_cast<const uint8_t*>(value.data()), length);
+    skip(floor_subtract(size, length));
+}
+
+void sha256_writer::write_string(const std::string& value)
+{
+    write_variable_little_endian(value.size());
+    write_bytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+void sha256_writer::skip(size_t size)
+{
+    for (size_t index = 0; index < size; ++index)
+        write_byte(string_terminator);
+}
+
+} // namespace libbitcoin
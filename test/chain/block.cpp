@@ -46,6 +46,18 @@ static bool all_valid(const chain::transaction::list& transactions)
     return valid;
 }
 
+// Test helper.
+static chain::chain_state::data test_state_data()
+{
+    chain::chain_state::data value;
+    value.height = 1;
+    value.hash = null_hash;
+    value.bits = { 0x1d00ffff, { 0x1d00ffff } };
+    value.version = { 1, { 1 } };
+    value.timestamp = { 0, 0, { 0 } };
+    return value;
+}
+
 BOOST_AUTO_TEST_SUITE(chain_block_tests)
 
 BOOST_AUTO_TEST_CASE(block__proof1__genesis_mainnet__expected)
@@ -719,4 +731,67 @@ BOOST_AUTO_TEST_CASE(block__is_forward_reference__forward_reference__true)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(block_connect_tests)
+
+BOOST_AUTO_TEST_CASE(block__connect_transactions__parallel_coinbase_only__success)
+{
+    threadpool pool(4);
+    const chain::chain_state state(test_state_data(), {}, 0);
+    const auto genesis = chain::block::genesis_mainnet();
+    BOOST_REQUIRE_EQUAL(genesis.connect_transactions(state, pool), error::success);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_transactions__parallel_missing_prevouts__matches_serial)
+{
+    threadpool pool(4);
+    const chain::chain_state state(test_state_data(), {}, 0);
+    chain::transaction coinbase{ 1, 0, { { { null_hash, chain::point::null_index }, {}, 0 } }, {} };
+    chain::transaction spend{ 1, 0, { { { coinbase.hash(), 0 }, {}, 0 }, { { coinbase.hash(), 1 }, {}, 0 } }, {} };
+    chain::block instance;
+    instance.set_transactions({ coinbase, spend, spend });
+    const auto serial = instance.connect_transactions(state);
+    BOOST_REQUIRE_EQUAL(serial, error::missing_previous_output);
+    BOOST_REQUIRE_EQUAL(instance.connect_transactions(state, pool), serial);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_transactions__parallel_empty_pool__matches_serial)
+{
+    threadpool pool;
+    const chain::chain_state state(test_state_data(), {}, 0);
+    chain::transaction coinbase{ 1, 0, { { { null_hash, chain::point::null_index }, {}, 0 } }, {} };
+    chain::transaction spend{ 1, 0, { { { coinbase.hash(), 0 }, {}, 0 } }, {} };
+    chain::block instance;
+    instance.set_transactions({ coinbase, spend });
+    BOOST_REQUIRE_EQUAL(instance.connect_transactions(state, pool), instance.connect_transactions(state));
+}
+
+BOOST_AUTO_TEST_CASE(block__connect_transactions__script_cached__skips_scripts)
+{
+    threadpool pool(4);
+    machine::script_cache scripts;
+    const chain::chain_state state(test_state_data(), {}, 0);
+    chain::transaction coinbase{ 1, 0, { { { null_hash, chain::point::null_index }, {}, 0 } }, {} };
+    chain::transaction spend{ 1, 0, { { { coinbase.hash(), 0 }, {}, 0 } }, {} };
+    chain::block instance;
+    instance.set_transactions({ coinbase, spend });
+    BOOST_REQUIRE_EQUAL(instance.connect_transactions(state, nullptr, &scripts), error::missing_previous_output);
+    BOOST_REQUIRE_EQUAL(instance.connect_transactions(state, pool, nullptr, &scripts), error::missing_previous_output);
+
+    // Serial connect caches each connected tx, here only the coinbase.
+    BOOST_REQUIRE_EQUAL(scripts.size(), 1u);
+
+    scripts.store(spend.hash(true), state.enabled_forks());
+    BOOST_REQUIRE_EQUAL(instance.connect_transactions(state, nullptr, &scripts), error::success);
+    BOOST_REQUIRE_EQUAL(instance.connect_transactions(state, pool, nullptr, &scripts), error::success);
+    BOOST_REQUIRE_EQUAL(instance.connect_transactions(state, pool), error::missing_previous_output);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
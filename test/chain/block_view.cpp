@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+BOOST_AUTO_TEST_SUITE(block_view_tests)
+
+BOOST_AUTO_TEST_CASE(block_view__constructor__empty__invalid)
+{
+    const data_chunk empty;
+    const block_view instance(empty);
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), 0u);
+    BOOST_REQUIRE(instance.transactions().empty());
+}
+
+BOOST_AUTO_TEST_CASE(block_view__constructor__truncated__invalid)
+{
+    auto data = block::genesis_mainnet().to_data();
+    data.pop_back();
+    const block_view instance(data);
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE(instance.transactions().empty());
+}
+
+BOOST_AUTO_TEST_CASE(block_view__accessors__genesis__expected)
+{
+    const auto genesis = block::genesis_mainnet();
+    const auto data = genesis.to_data();
+    const block_view instance(data);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), data.size());
+    BOOST_REQUIRE(instance.hash() == genesis.hash());
+    BOOST_REQUIRE(instance.to_header() == genesis.header());
+    BOOST_REQUIRE_EQUAL(instance.transactions().size(), 1u);
+    BOOST_REQUIRE(instance.transactions().front().hash() == genesis.transactions().front().hash());
+    BOOST_REQUIRE(instance.to_block() == genesis);
+}
+
+BOOST_AUTO_TEST_CASE(block_view__constructor__owned_buffer__shared_by_copies)
+{
+    const auto genesis = block::genesis_mainnet();
+    auto data = genesis.to_data();
+    const auto address = data.data();
+    std::shared_ptr<block_view> copy;
+
+    {
+        const block_view instance(std::move(data));
+        BOOST_REQUIRE(instance.is_valid());
+        BOOST_REQUIRE(instance.data().begin() == address);
+        copy = std::make_shared<block_view>(instance);
+    }
+
+    BOOST_REQUIRE(copy->is_valid());
+    BOOST_REQUIRE(copy->data().begin() == address);
+    BOOST_REQUIRE(copy->hash() == genesis.hash());
+    BOOST_REQUIRE(copy->transactions().front().hash() == genesis.transactions().front().hash());
+    BOOST_REQUIRE(copy->to_block() == genesis);
+}
+
+BOOST_AUTO_TEST_CASE(block_view__constructor__owned_invalid_buffer__invalid)
+{
+    auto data = block::genesis_mainnet().to_data();
+    data.pop_back();
+    const block_view instance(std::move(data));
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(block_view__transactions__witness__expected)
+{
+    auto block = block::genesis_mainnet();
+    const witness stack(data_stack{ { 0x2a } });
+    const input::list inputs
+    {
+        { { block.transactions().front().hash(), 0 }, {}, stack, 0 }
+    };
+
+    auto transactions = block.transactions();
+    transactions.push_back({ 1, 0, inputs, {} });
+    block.set_transactions(transactions);
+    const auto data = block.to_data(true);
+    const block_view instance(data);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), data.size());
+    BOOST_REQUIRE_EQUAL(instance.transactions().size(), 2u);
+
+    const auto& view = instance.transactions().back();
+    const auto& tx = block.transactions().back();
+    BOOST_REQUIRE(view.is_segregated());
+    BOOST_REQUIRE(view.hash() == tx.hash());
+    BOOST_REQUIRE(view.hash(true) == tx.hash(true));
+    BOOST_REQUIRE(instance.to_block().to_data(true) == data);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::machine;
+
+BOOST_AUTO_TEST_SUITE(chain_state_tests)
+
+static const uint32_t test_forks = rule_fork::bip34_activations;
+static const uint32_t test_bits = no_retarget_proof_of_work_limit;
+static const size_t test_versions = testnet_sample;
+
+static chain::chain_state::data test_state_data(size_t height)
+{
+    chain::chain_state::data value;
+    value.height = height;
+    value.hash = null_hash;
+    value.allow_collisions_hash = null_hash;
+    value.bip9_bit0_hash = null_hash;
+    value.bip9_bit1_hash = null_hash;
+    value.bits = { test_bits, { test_bits } };
+    value.version.self = 1;
+    value.timestamp = { 1000, 0, {} };
+
+    for (size_t index = 0; index < test_versions; ++index)
+        value.version.ordered.push_back(1);
+
+    for (uint32_t index = 0; index < median_time_past_interval; ++index)
+        value.timestamp.ordered.push_back(1000 + (index * 7919u) % 601u);
+
+    return value;
+}
+
+// Promote expected data by the header, as a populated state would be.
+static void test_promote(chain::chain_state::data& data,
+    const chain::header& header)
+{
+    data.height++;
+    data.hash = header.hash();
+    data.bits.ordered.push_back(data.bits.self);
+    data.bits.ordered.pop_front();
+    data.bits.self = header.bits();
+    data.version.ordered.push_back(data.version.self);
+    data.version.ordered.pop_front();
+    data.version.self = header.version();
+    data.timestamp.ordered.push_back(data.timestamp.self);
+    data.timestamp.ordered.pop_front();
+    data.timestamp.self = header.timestamp();
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__constructor__promoted__matches_populated)
+{
+    const size_t height = 1000;
+    auto expected = test_state_data(height);
+    auto state = std::make_shared<chain::chain_state>(
+        test_state_data(height), chain::chain_state::checkpoints{}, test_forks);
+
+    for (uint32_t index = 0; index < 300; ++index)
+    {
+        // Cross the enforcement thresholds in both directions, including
+        // versions that are negative as signed values.
+        const uint32_t version = index < 50 ? 1 : index < 150 ? 4 :
+            index < 200 ? 0xffffffff : 2;
+        const uint32_t timestamp = 1000 + (index * 104729u) % 997u;
+        const chain::header header(version, null_hash, null_hash, timestamp,
+            test_bits, index);
+
+        state = std::make_shared<chain::chain_state>(*state, header);
+        test_promote(expected, header);
+
+        auto copy = expected;
+        const chain::chain_state populated(std::move(copy), {}, test_forks);
+        BOOST_REQUIRE_EQUAL(state->height(), populated.height());
+        BOOST_REQUIRE_EQUAL(state->enabled_forks(), populated.enabled_forks());
+        BOOST_REQUIRE_EQUAL(state->minimum_block_version(), populated.minimum_block_version());
+        BOOST_REQUIRE_EQUAL(state->median_time_past(), populated.median_time_past());
+        BOOST_REQUIRE_EQUAL(state->work_required(), populated.work_required());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__median_time_past__unordered__median)
+{
+    auto data = test_state_data(1000);
+    data.timestamp.ordered = { 9, 1, 8, 2, 7, 3, 6, 4, 5, 11, 10 };
+    const chain::chain_state state(std::move(data), {}, test_forks);
+    BOOST_REQUIRE_EQUAL(state.median_time_past(), 6u);
+}
+
+BOOST_AUTO_TEST_CASE(chain_state__minimum_block_version__enforced__bip65)
+{
+    auto data = test_state_data(1000);
+    data.version.ordered.clear();
+
+    for (size_t index = 0; index < test_versions; ++index)
+        data.version.ordered.push_back(index < testnet_enforce ? 4 : 1);
+
+    const chain::chain_state state(std::move(data), {}, test_forks);
+    BOOST_REQUIRE_EQUAL(state.minimum_block_version(), bip65_version);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
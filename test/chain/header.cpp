@@ -18,12 +18,49 @@
  */
 #include <boost/test/unit_test.hpp>
 #include <chrono>
+#include <vector>
 #include <bitcoin/bitcoin.hpp>
 
 using namespace bc;
 
 BOOST_AUTO_TEST_SUITE(chain_header_tests)
 
+static const uint32_t test_bits = no_retarget_proof_of_work_limit;
+
+static chain::chain_state::data test_state_data(const hash_digest& hash)
+{
+    chain::chain_state::data value;
+    value.height = 1;
+    value.hash = hash;
+    value.bits = { test_bits, { test_bits } };
+    value.version = { 1, { 1 } };
+    value.timestamp = { 100, 0, { 0 } };
+    return value;
+}
+
+static void test_mine(chain::header& header)
+{
+    while (!header.is_valid_proof_of_work(false))
+        header.set_nonce(header.nonce() + 1);
+}
+
+static chain::header::list test_headers(const hash_digest& parent,
+    size_t count)
+{
+    chain::header::list headers;
+    auto previous = parent;
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        chain::header header(1, previous, null_hash, 1000 + index, test_bits, 0);
+        test_mine(header);
+        previous = header.hash();
+        headers.push_back(header);
+    }
+
+    return headers;
+}
+
 BOOST_AUTO_TEST_CASE(header__constructor_1__always__initialized_invalid)
 {
     chain::header instance;
@@ -501,4 +538,108 @@ BOOST_AUTO_TEST_CASE(header__operator_boolean_not_equals__differs__returns_true)
     BOOST_REQUIRE(instance != expected);
 }
 
+BOOST_AUTO_TEST_CASE(header__validate__empty__null_state)
+{
+    threadpool pool(2);
+    const auto parent_hash = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    const chain::chain_state parent(test_state_data(parent_hash), {}, 0);
+    std::vector<code> results{ error::success };
+    BOOST_REQUIRE(!chain::header::validate({}, parent, pool, results));
+    BOOST_REQUIRE(results.empty());
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(header__validate__valid_chain__matches_serial_state)
+{
+    threadpool pool(4);
+    const auto parent_hash = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    const chain::chain_state parent(test_state_data(parent_hash), {}, 0);
+    const auto headers = test_headers(parent_hash, 100);
+
+    std::vector<code> results;
+    const auto state = chain::header::validate(headers, parent, pool, results);
+    BOOST_REQUIRE(state);
+    BOOST_REQUIRE_EQUAL(results.size(), headers.size());
+
+    for (const auto& result: results)
+        BOOST_REQUIRE_EQUAL(result, error::success);
+
+    auto serial = std::make_shared<chain::chain_state>(parent, headers.front());
+
+    for (size_t index = 1; index < headers.size(); ++index)
+        serial = std::make_shared<chain::chain_state>(*serial, headers[index]);
+
+    BOOST_REQUIRE_EQUAL(state->height(), parent.height() + headers.size());
+    BOOST_REQUIRE_EQUAL(state->height(), serial->height());
+    BOOST_REQUIRE_EQUAL(state->enabled_forks(), serial->enabled_forks());
+    BOOST_REQUIRE_EQUAL(state->minimum_block_version(), serial->minimum_block_version());
+    BOOST_REQUIRE_EQUAL(state->median_time_past(), serial->median_time_past());
+    BOOST_REQUIRE_EQUAL(state->work_required(), serial->work_required());
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(header__validate__unlinked__orphans_above_failure)
+{
+    threadpool pool(4);
+    const auto parent_hash = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    const chain::chain_state parent(test_state_data(parent_hash), {}, 0);
+    auto headers = test_headers(parent_hash, 10);
+    headers[5].set_previous_block_hash(null_hash);
+    test_mine(headers[5]);
+
+    std::vector<code> results;
+    const auto state = chain::header::validate(headers, parent, pool, results);
+    BOOST_REQUIRE(state);
+    BOOST_REQUIRE_EQUAL(state->height(), parent.height() + 5u);
+    BOOST_REQUIRE_EQUAL(results[4], error::success);
+    BOOST_REQUIRE_EQUAL(results[5], error::invalid_previous_block);
+    BOOST_REQUIRE_EQUAL(results[6], error::orphan_block);
+    BOOST_REQUIRE_EQUAL(results[9], error::orphan_block);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(header__validate__unaccepted__state_of_last_valid)
+{
+    threadpool pool(4);
+    const auto parent_hash = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    const chain::chain_state parent(test_state_data(parent_hash), {}, 0);
+    auto headers = test_headers(parent_hash, 10);
+    headers[3].set_timestamp(0);
+    test_mine(headers[3]);
+
+    std::vector<code> results;
+    const auto state = chain::header::validate(headers, parent, pool, results);
+    BOOST_REQUIRE(state);
+    BOOST_REQUIRE_EQUAL(results[2], error::success);
+    BOOST_REQUIRE_EQUAL(results[3], error::timestamp_too_early);
+    BOOST_REQUIRE_EQUAL(results[4], error::orphan_block);
+
+    const chain::chain_state expected(chain::chain_state(
+        chain::chain_state(parent, headers[0]), headers[1]), headers[2]);
+    BOOST_REQUIRE_EQUAL(state->height(), expected.height());
+    BOOST_REQUIRE_EQUAL(state->median_time_past(), expected.median_time_past());
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(header__validate__invalid_first__null_state)
+{
+    threadpool pool(4);
+    const auto parent_hash = hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+    const chain::chain_state parent(test_state_data(parent_hash), {}, 0);
+    auto headers = test_headers(parent_hash, 3);
+    headers[0].set_bits(retarget_proof_of_work_limit);
+
+    std::vector<code> results;
+    BOOST_REQUIRE(!chain::header::validate(headers, parent, pool, results));
+    BOOST_REQUIRE_EQUAL(results[0], error::invalid_proof_of_work);
+    BOOST_REQUIRE_EQUAL(results[1], error::orphan_block);
+    BOOST_REQUIRE_EQUAL(results[2], error::orphan_block);
+    pool.shutdown();
+    pool.join();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
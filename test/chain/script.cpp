@@ -130,6 +130,81 @@ std::string test_name(const script_test& test)
     return out.str();
 }
 
+// Construct a transaction with three inputs and three outputs.
+transaction new_sighash_tx()
+{
+    static const auto hash = hash_literal("b3807042c92f449bbf79b33ca59d7dfec7f4cc71096704a9c526dddf496ee097");
+
+    script output_script;
+    output_script.from_string("dup hash160 [18c0bd8d1818f1bf99cb1df2269c645318ef7b73] equalverify checksig");
+
+    script input_script;
+    input_script.from_string("[0102030405] [060708]");
+
+    return transaction
+    {
+        1,
+        42,
+        input::list
+        {
+            input{ { hash, 0 }, input_script, 0xfffffffe },
+            input{ { hash, 1 }, input_script, 0xfffffffd },
+            input{ { hash, 2 }, input_script, 0xfffffffc }
+        },
+        output::list
+        {
+            output{ 1000, output_script },
+            output{ 2000, output_script },
+            output{ 3000, output_script }
+        }
+    };
+}
+
+// Compute the unversioned signature hash by modifying a copy of the tx.
+hash_digest reference_sighash(const transaction& tx, uint32_t index,
+    const script& script_code, uint8_t sighash_type)
+{
+    operation::list ops;
+    for (const auto& op: script_code.operations())
+        if (op.code() != opcode::codeseparator)
+            ops.push_back(op);
+
+    const auto mask = sighash_type & sighash_algorithm::mask;
+    const auto any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
+    const auto none = mask == sighash_algorithm::none;
+    const auto single = mask == sighash_algorithm::single;
+
+    auto inputs = tx.inputs();
+    for (auto& input: inputs)
+    {
+        input.set_script({});
+        if (none || single)
+            input.set_sequence(0);
+    }
+
+    inputs[index].set_script(script(ops));
+    inputs[index].set_sequence(tx.inputs()[index].sequence());
+
+    if (any)
+        inputs = { inputs[index] };
+
+    auto outputs = tx.outputs();
+    if (none)
+        outputs.clear();
+
+    if (single)
+    {
+        outputs.resize(index + 1);
+        for (size_t out = 0; out < index; ++out)
+            outputs[out] = output{};
+    }
+
+    const transaction copy(tx.version(), tx.locktime(), inputs, outputs);
+    auto serialized = copy.to_data(true, false);
+    extend_data(serialized, to_little_endian<uint32_t>(sighash_type));
+    return bitcoin_hash(serialized);
+}
+
 BOOST_AUTO_TEST_SUITE(script_tests)
 
 // Serialization tests.
@@ -667,6 +742,67 @@ BOOST_AUTO_TEST_CASE(script__generate_signature_hash__all__expected)
     BOOST_REQUIRE_EQUAL(result, expected);
 }
 
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__all_inputs__matches_reference)
+{
+    const auto tx = new_sighash_tx();
+    script script_code;
+    BOOST_REQUIRE(script_code.from_string("dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] equalverify checksig"));
+
+    for (uint32_t index = 0; index < tx.inputs().size(); ++index)
+        BOOST_REQUIRE_EQUAL(encode_base16(script::generate_signature_hash(tx, index, script_code, sighash_algorithm::all)),
+            encode_base16(reference_sighash(tx, index, script_code, sighash_algorithm::all)));
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__none_inputs__matches_reference)
+{
+    const auto tx = new_sighash_tx();
+    script script_code;
+    BOOST_REQUIRE(script_code.from_string("dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] equalverify checksig"));
+
+    for (uint32_t index = 0; index < tx.inputs().size(); ++index)
+        BOOST_REQUIRE_EQUAL(encode_base16(script::generate_signature_hash(tx, index, script_code, sighash_algorithm::none)),
+            encode_base16(reference_sighash(tx, index, script_code, sighash_algorithm::none)));
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__single_inputs__matches_reference)
+{
+    const auto tx = new_sighash_tx();
+    script script_code;
+    BOOST_REQUIRE(script_code.from_string("dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] equalverify checksig"));
+
+    for (uint32_t index = 0; index < tx.inputs().size(); ++index)
+        BOOST_REQUIRE_EQUAL(encode_base16(script::generate_signature_hash(tx, index, script_code, sighash_algorithm::single)),
+            encode_base16(reference_sighash(tx, index, script_code, sighash_algorithm::single)));
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__anyone_can_pay_inputs__matches_reference)
+{
+    const auto tx = new_sighash_tx();
+    script script_code;
+    BOOST_REQUIRE(script_code.from_string("dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] equalverify checksig"));
+
+    for (uint32_t index = 0; index < tx.inputs().size(); ++index)
+    {
+        BOOST_REQUIRE_EQUAL(encode_base16(script::generate_signature_hash(tx, index, script_code, sighash_algorithm::all_anyone_can_pay)),
+            encode_base16(reference_sighash(tx, index, script_code, sighash_algorithm::all_anyone_can_pay)));
+        BOOST_REQUIRE_EQUAL(encode_base16(script::generate_signature_hash(tx, index, script_code, sighash_algorithm::none_anyone_can_pay)),
+            encode_base16(reference_sighash(tx, index, script_code, sighash_algorithm::none_anyone_can_pay)));
+        BOOST_REQUIRE_EQUAL(encode_base16(script::generate_signature_hash(tx, index, script_code, sighash_algorithm::single_anyone_can_pay)),
+            encode_base16(reference_sighash(tx, index, script_code, sighash_algorithm::single_anyone_can_pay)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(script__generate_signature_hash__code_separators__matches_reference)
+{
+    const auto tx = new_sighash_tx();
+    script script_code;
+    BOOST_REQUIRE(script_code.from_string("codeseparator dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] codeseparator equalverify checksig"));
+
+    for (uint32_t index = 0; index < tx.inputs().size(); ++index)
+        BOOST_REQUIRE_EQUAL(encode_base16(script::generate_signature_hash(tx, index, script_code, sighash_algorithm::all)),
+            encode_base16(reference_sighash(tx, index, script_code, sighash_algorithm::all)));
+}
+
 // Ad-hoc test cases.
 //-----------------------------------------------------------------------------
 
@@ -17,6 +17,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
 #include <bitcoin/bitcoin.hpp>
 
 using namespace bc;
@@ -582,6 +585,36 @@ BOOST_AUTO_TEST_CASE(transaction__factory_data_3__case_2__success)
     BOOST_REQUIRE(resave == raw_tx);
 }
 
+BOOST_AUTO_TEST_CASE(transaction__from_data__byte_deserializer__matches_reader)
+{
+    static const data_chunk raw_tx = to_chunk(base16_literal(TX4));
+    const auto begin = raw_tx.data();
+    auto source = make_safe_deserializer(begin, begin + raw_tx.size());
+    chain::transaction tx;
+    BOOST_REQUIRE(tx.from_data(source));
+    BOOST_REQUIRE(source.is_exhausted());
+    BOOST_REQUIRE(tx.hash() == hash_literal(TX4_HASH));
+
+    data_source stream(raw_tx);
+    istream_reader reader(stream);
+    BOOST_REQUIRE(tx == chain::transaction::factory(reader));
+
+    data_chunk resave(raw_tx.size());
+    auto sink = make_unsafe_serializer(resave.data());
+    tx.to_data(sink);
+    BOOST_REQUIRE(resave == raw_tx);
+}
+
+BOOST_AUTO_TEST_CASE(transaction__from_data__byte_deserializer_truncated__failure)
+{
+    static const data_chunk raw_tx = to_chunk(base16_literal(TX4));
+    const auto begin = raw_tx.data();
+    auto source = make_safe_deserializer(begin, begin + raw_tx.size() - 1);
+    chain::transaction tx;
+    BOOST_REQUIRE(!tx.from_data(source));
+    BOOST_REQUIRE(!tx.is_valid());
+}
+
 BOOST_AUTO_TEST_CASE(transaction__version__roundtrip__success)
 {
     uint32_t version = 1254u;
@@ -1063,4 +1096,28 @@ BOOST_AUTO_TEST_CASE(transaction__hash__block320670__success)
     BOOST_REQUIRE(data == instance.to_data());
 }
 
+BOOST_AUTO_TEST_CASE(transaction__hash__concurrent__consistent)
+{
+    static const size_t threads = 8;
+    static const auto expected = hash_literal(TX7_HASH);
+    static const auto data = to_chunk(base16_literal(TX7));
+    chain::transaction instance;
+    BOOST_REQUIRE(instance.from_data(data));
+
+    std::vector<hash_digest> hashes(threads, null_hash);
+    std::vector<std::thread> workers;
+
+    for (size_t index = 0; index < threads; ++index)
+        workers.emplace_back([&, index]()
+        {
+            hashes[index] = instance.hash();
+        });
+
+    for (auto& worker: workers)
+        worker.join();
+
+    for (const auto& hash: hashes)
+        BOOST_REQUIRE(hash == expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+
+BOOST_AUTO_TEST_SUITE(transaction_view_tests)
+
+#define TX1 \
+"0100000001f08e44a96bfb5ae63eda1a6620adae37ee37ee4777fb0336e1bbbc" \
+"4de65310fc010000006a473044022050d8368cacf9bf1b8fb1f7cfd9aff63294" \
+"789eb1760139e7ef41f083726dadc4022067796354aba8f2e02363c5e510aa7e" \
+"2830b115472fb31de67d16972867f13945012103e589480b2f746381fca01a9b" \
+"12c517b7a482a203c8b2742985da0ac72cc078f2ffffffff02f0c9c467000000" \
+"001976a914d9d78e26df4e4601cf9b26d09c7b280ee764469f88ac80c4600f00" \
+"0000001976a9141ee32412020a324b93b1a1acfdfff6ab9ca8fac288ac000000" \
+"00"
+
+#define TX1_HASH \
+"bf7c3f5a69a78edd81f3eff7e93a37fb2d7da394d48db4d85e7e5353b9b8e270"
+
+static transaction make_witness_transaction()
+{
+    const chain::script script(script::to_pay_key_hash_pattern(null_short_hash));
+    const witness stack(data_stack{ { 0x01, 0x02 }, { 0x03 } });
+    const input::list inputs
+    {
+        { { hash_literal(TX1_HASH), 1 }, {}, stack, 0xfffffffe },
+        { { hash_literal(TX1_HASH), 0 }, {}, {}, max_input_sequence }
+    };
+    const output::list outputs
+    {
+        { 42, script }
+    };
+
+    return{ 2, 17, inputs, outputs };
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__constructor__empty__invalid)
+{
+    const data_chunk empty;
+    const transaction_view instance(empty);
+    BOOST_REQUIRE(!instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.inputs(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.outputs(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__constructor__truncated__invalid)
+{
+    data_chunk data;
+    BOOST_REQUIRE(decode_base16(data, TX1));
+    data.pop_back();
+    const transaction_view instance(data);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__constructor__non_minimal_size__invalid)
+{
+    // One input, empty script, no outputs, zero locktime.
+    const auto data = to_chunk(base16_literal(
+        "01000000" "01" "0000000000000000000000000000000000000000000000000000000000000000ffffffff"
+        "fd0000" "ffffffff" "00" "00000000"));
+    const transaction_view instance(data);
+    BOOST_REQUIRE(!instance.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__constructor__trailing_bytes__excluded)
+{
+    data_chunk data;
+    BOOST_REQUIRE(decode_base16(data, TX1));
+    const auto size = data.size();
+    data.push_back(0x42);
+    const transaction_view instance(data);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), size);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__accessors__tx1__expected)
+{
+    data_chunk data;
+    BOOST_REQUIRE(decode_base16(data, TX1));
+    const auto tx = transaction::factory(data);
+    const transaction_view instance(data);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), data.size());
+    BOOST_REQUIRE_EQUAL(instance.version(), tx.version());
+    BOOST_REQUIRE_EQUAL(instance.locktime(), tx.locktime());
+    BOOST_REQUIRE(!instance.is_coinbase());
+    BOOST_REQUIRE(!instance.is_segregated());
+    BOOST_REQUIRE(instance.hash() == hash_literal(TX1_HASH));
+    BOOST_REQUIRE(instance.hash(true) == hash_literal(TX1_HASH));
+    BOOST_REQUIRE_EQUAL(instance.inputs(), tx.inputs().size());
+    BOOST_REQUIRE_EQUAL(instance.outputs(), tx.outputs().size());
+
+    for (size_t index = 0; index < instance.inputs(); ++index)
+    {
+        const auto& input = tx.inputs()[index];
+        BOOST_REQUIRE(instance.previous_output(index) == input.previous_output());
+        BOOST_REQUIRE(to_chunk(instance.input_script(index)) == input.script().to_data(false));
+        BOOST_REQUIRE_EQUAL(instance.sequence(index), input.sequence());
+        BOOST_REQUIRE(instance.witness(index).empty());
+    }
+
+    for (size_t index = 0; index < instance.outputs(); ++index)
+    {
+        const auto& output = tx.outputs()[index];
+        BOOST_REQUIRE_EQUAL(instance.value(index), output.value());
+        BOOST_REQUIRE(to_chunk(instance.output_script(index)) == output.script().to_data(false));
+    }
+
+    BOOST_REQUIRE(instance.to_transaction() == tx);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__hash__witness__matches_transaction)
+{
+    const auto tx = make_witness_transaction();
+    const auto data = tx.to_data(true, true);
+    const transaction_view instance(data);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.is_segregated());
+    BOOST_REQUIRE_EQUAL(instance.serialized_size(), data.size());
+    BOOST_REQUIRE_EQUAL(instance.version(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.locktime(), 17u);
+    BOOST_REQUIRE(instance.hash() == tx.hash());
+    BOOST_REQUIRE(instance.hash(true) == tx.hash(true));
+    BOOST_REQUIRE(instance.hash() != instance.hash(true));
+    BOOST_REQUIRE_EQUAL(instance.sequence(0), 0xfffffffeu);
+    BOOST_REQUIRE(to_chunk(instance.witness(0)) == tx.inputs()[0].witness().to_data(true));
+    BOOST_REQUIRE(to_chunk(instance.witness(1)) == tx.inputs()[1].witness().to_data(true));
+    BOOST_REQUIRE_EQUAL(instance.value(0), 42u);
+    BOOST_REQUIRE(instance.to_transaction().to_data(true, true) == data);
+}
+
+BOOST_AUTO_TEST_CASE(transaction_view__hash__coinbase__matches_transaction)
+{
+    const auto genesis = block::genesis_mainnet();
+    const auto& tx = genesis.transactions().front();
+    const auto data = tx.to_data();
+    const transaction_view instance(data);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.is_coinbase());
+    BOOST_REQUIRE(instance.hash() == tx.hash());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::machine;
+
+BOOST_AUTO_TEST_SUITE(decoded_script_tests)
+
+// Compare decoding to the operation list parse of the same bytes.
+static void require_matches_operations(const data_chunk& bytes)
+{
+    const script instance(data_chunk(bytes), false);
+    const auto& ops = instance.operations();
+    const decoded_script decoded(bytes);
+
+    BOOST_REQUIRE_EQUAL(decoded.size(), ops.size());
+    BOOST_REQUIRE_EQUAL(decoded.is_valid(), instance.is_valid_operations());
+
+    for (size_t index = 0; index < ops.size(); ++index)
+    {
+        BOOST_REQUIRE(decoded.code(index) == ops[index].code());
+        BOOST_REQUIRE(to_chunk(decoded.data(index)) == ops[index].data());
+    }
+
+    BOOST_REQUIRE_EQUAL(decoded.sigops(false), instance.sigops(false));
+    BOOST_REQUIRE_EQUAL(decoded.sigops(true), instance.sigops(true));
+    BOOST_REQUIRE_EQUAL(decoded.is_witness_program_pattern(), script::is_witness_program_pattern(ops));
+    BOOST_REQUIRE_EQUAL(decoded.is_pay_script_hash_pattern(), script::is_pay_script_hash_pattern(ops));
+}
+
+BOOST_AUTO_TEST_CASE(decoded_script__construct__empty__valid_empty)
+{
+    const data_chunk bytes;
+    const decoded_script instance(bytes);
+    BOOST_REQUIRE(instance.is_valid());
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.sigops(true), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(decoded_script__construct__standard_patterns__matches_operations)
+{
+    script multisig;
+    BOOST_REQUIRE(multisig.from_string("2 [03dcfd9e580de35d8c2060d76dbf9e5561fe20febd2e64380e860a4d59f15ac864] [02440e0304bf8d32b2012994393c6a477acf238dd6adb4c3cef5bfa72f30c9861c] [03624505c6cc3967352cce480d8550490dd68519cd019066a4c302fdfb7d1c9934] 3 checkmultisig"));
+
+    require_matches_operations(script(script::to_pay_key_hash_pattern(null_short_hash)).to_data(false));
+    require_matches_operations(script(script::to_pay_script_hash_pattern(null_short_hash)).to_data(false));
+    require_matches_operations(multisig.to_data(false));
+    require_matches_operations(to_chunk(base16_literal("0014751e76e8199196d454941c45d1b3a323f1433bd6")));
+}
+
+BOOST_AUTO_TEST_CASE(decoded_script__construct__push_encodings__matches_operations)
+{
+    require_matches_operations(to_chunk(base16_literal("4c03aabbccac")));
+    require_matches_operations(to_chunk(base16_literal("4d0300aabbccad")));
+    require_matches_operations(to_chunk(base16_literal("4e03000000aabbccae")));
+}
+
+BOOST_AUTO_TEST_CASE(decoded_script__construct__truncated__invalid_matches_operations)
+{
+    require_matches_operations(to_chunk(base16_literal("ac05aabb")));
+    require_matches_operations(to_chunk(base16_literal("ac4c")));
+    require_matches_operations(to_chunk(base16_literal("ac4d01")));
+    require_matches_operations(to_chunk(base16_literal("ac4effffffff00")));
+}
+
+BOOST_AUTO_TEST_CASE(decoded_script__data__push__references_bytes)
+{
+    const auto bytes = base16_literal("03aabbccac");
+    const decoded_script instance(bytes);
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u);
+    BOOST_REQUIRE(instance.data(0).data() == bytes.data() + 1);
+    BOOST_REQUIRE_EQUAL(instance.data(0).size(), 3u);
+    BOOST_REQUIRE(instance.data(1).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::machine;
+
+BOOST_AUTO_TEST_SUITE(script_cache_tests)
+
+static const auto hash = hash_literal("ce8f4b713ffdd2658900845251890f30371856be201cd1f5b3d970f793634333");
+
+BOOST_AUTO_TEST_CASE(script_cache__constructor__default__empty)
+{
+    const script_cache instance;
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_GT(instance.capacity(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.hits(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.misses(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(script_cache__store__stored__contains_only_same_forks)
+{
+    script_cache instance;
+    BOOST_REQUIRE(!instance.contains(hash, rule_fork::all_rules));
+    instance.store(hash, rule_fork::all_rules);
+    instance.store(hash, rule_fork::all_rules);
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE(instance.contains(hash, rule_fork::all_rules));
+    BOOST_REQUIRE(!instance.contains(hash, rule_fork::no_rules));
+    BOOST_REQUIRE(!instance.contains(null_hash, rule_fork::all_rules));
+    BOOST_REQUIRE_EQUAL(instance.hits(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.misses(), 3u);
+
+    instance.clear();
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(!instance.contains(hash, rule_fork::all_rules));
+}
+
+BOOST_AUTO_TEST_CASE(script_cache__store__over_capacity__bounded)
+{
+    script_cache instance(0);
+    const auto capacity = instance.capacity();
+    BOOST_REQUIRE_GT(capacity, 0u);
+
+    for (uint32_t forks = 0; forks < 4 * capacity; ++forks)
+        instance.store(hash, forks);
+
+    BOOST_REQUIRE_GT(instance.size(), 0u);
+    BOOST_REQUIRE_LE(instance.size(), capacity);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
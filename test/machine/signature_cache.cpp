@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::machine;
+
+BOOST_AUTO_TEST_SUITE(signature_cache_tests)
+
+static const auto secret = hash_literal("ce8f4b713ffdd2658900845251890f30371856be201cd1f5b3d970f793634333");
+
+static transaction spending_tx()
+{
+    const input::list inputs{ { { null_hash, 0 }, {}, max_input_sequence } };
+    const output::list outputs{ { 90000, {} } };
+    return{ 1, 0, inputs, outputs };
+}
+
+// Create a p2pkh input script for the tx, endorsed by the given secret.
+static script endorse(const transaction& tx, const script& prevout_script,
+    const ec_secret& signer, const ec_compressed& point)
+{
+    endorsement out;
+    BOOST_REQUIRE(script::create_endorsement(out, signer, prevout_script, tx, 0, sighash_algorithm::all));
+    return script(operation::list{ { out }, { to_chunk(point) } });
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__constructor__default__empty)
+{
+    const signature_cache instance;
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_GT(instance.capacity(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.hits(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.misses(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__store__stored__contains_and_counts)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+
+    ec_signature signature;
+    const auto hash = bitcoin_hash(to_chunk(point));
+    BOOST_REQUIRE(sign(signature, secret, hash));
+
+    signature_cache instance;
+    BOOST_REQUIRE(!instance.contains(hash, point, signature));
+    instance.store(hash, point, signature);
+    instance.store(hash, point, signature);
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE(instance.contains(hash, point, signature));
+    BOOST_REQUIRE(!instance.contains(null_hash, point, signature));
+    BOOST_REQUIRE_EQUAL(instance.hits(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.misses(), 2u);
+
+    instance.clear();
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(!instance.contains(hash, point, signature));
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__store__over_capacity__bounded)
+{
+    ec_signature signature{};
+    signature_cache instance(0);
+    const auto capacity = instance.capacity();
+    BOOST_REQUIRE_GT(capacity, 0u);
+
+    for (size_t index = 0; index < 4 * capacity; ++index)
+        instance.store(sha256_hash(to_chunk(to_little_endian(index))), data_chunk{}, signature);
+
+    BOOST_REQUIRE_GT(instance.size(), 0u);
+    BOOST_REQUIRE_LE(instance.size(), capacity);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__script_verify__valid_signature__cached_and_hit)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+    const script prevout_script(script::to_pay_key_hash_pattern(bitcoin_short_hash(point)));
+    const auto tx = spending_tx();
+    const auto input_script = endorse(tx, prevout_script, secret, point);
+
+    signature_cache cache;
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, rule_fork::all_rules, input_script, {}, prevout_script, 100000, nullptr, &cache), error::success);
+    BOOST_REQUIRE_EQUAL(cache.size(), 1u);
+    BOOST_REQUIRE_EQUAL(cache.hits(), 0u);
+
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, rule_fork::all_rules, input_script, {}, prevout_script, 100000, nullptr, &cache), error::success);
+    BOOST_REQUIRE_EQUAL(cache.hits(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__script_verify__invalid_signature__not_cached)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+    const script prevout_script(script::to_pay_key_hash_pattern(bitcoin_short_hash(point)));
+    const auto tx = spending_tx();
+    const auto other = hash_literal("0000000000000000000000000000000000000000000000000000000000000042");
+    const auto input_script = endorse(tx, prevout_script, other, point);
+
+    signature_cache cache;
+    BOOST_REQUIRE(script::verify(tx, 0, rule_fork::all_rules, input_script, {}, prevout_script, 100000, nullptr, &cache) != error::success);
+    BOOST_REQUIRE_EQUAL(cache.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(signature_cache__signature_queue_verify__valid__stored_then_hit)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+
+    ec_signature signature;
+    const auto hash = bitcoin_hash(to_chunk(point));
+    BOOST_REQUIRE(sign(signature, secret, hash));
+
+    signature_cache cache;
+    signature_queue deferred(&cache);
+    deferred.enqueue(to_chunk(point), hash, signature);
+    BOOST_REQUIRE(deferred.verify());
+    BOOST_REQUIRE(cache.contains(hash, point, signature));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+using namespace bc::chain;
+using namespace bc::machine;
+
+BOOST_AUTO_TEST_SUITE(signature_queue_tests)
+
+static const auto secret = hash_literal("ce8f4b713ffdd2658900845251890f30371856be201cd1f5b3d970f793634333");
+
+static transaction spending_tx()
+{
+    const input::list inputs{ { { null_hash, 0 }, {}, max_input_sequence } };
+    const output::list outputs{ { 90000, {} } };
+    return{ 1, 0, inputs, outputs };
+}
+
+// Create a p2pkh input script for the tx, endorsed by the given secret.
+static script endorse(const transaction& tx, const script& prevout_script,
+    const ec_secret& signer, const ec_compressed& point)
+{
+    endorsement out;
+    BOOST_REQUIRE(script::create_endorsement(out, signer, prevout_script, tx, 0, sighash_algorithm::all));
+    return script(operation::list{ { out }, { to_chunk(point) } });
+}
+
+BOOST_AUTO_TEST_CASE(signature_queue__constructor__always__empty)
+{
+    const signature_queue instance;
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(instance.verify());
+}
+
+BOOST_AUTO_TEST_CASE(signature_queue__verify__valid_and_invalid__expected)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+
+    ec_signature signature;
+    const auto hash = bitcoin_hash(to_chunk(point));
+    BOOST_REQUIRE(sign(signature, secret, hash));
+
+    signature_queue instance;
+    instance.enqueue(to_chunk(point), hash, signature);
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE(instance.verify(0));
+    BOOST_REQUIRE(instance.verify());
+
+    instance.enqueue(to_chunk(point), null_hash, signature);
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u);
+    BOOST_REQUIRE(!instance.verify(1));
+    BOOST_REQUIRE(!instance.verify());
+
+    instance.clear();
+    BOOST_REQUIRE(instance.empty());
+}
+
+BOOST_AUTO_TEST_CASE(signature_queue__script_verify__valid_signature__deferred_and_verifies)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+    const script prevout_script(script::to_pay_key_hash_pattern(bitcoin_short_hash(point)));
+    const auto tx = spending_tx();
+    const auto input_script = endorse(tx, prevout_script, secret, point);
+
+    signature_queue deferred;
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, rule_fork::all_rules, input_script, {}, prevout_script, 100000, &deferred), error::success);
+    BOOST_REQUIRE_EQUAL(deferred.size(), 1u);
+    BOOST_REQUIRE(deferred.verify());
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, rule_fork::all_rules, input_script, {}, prevout_script, 100000), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(signature_queue__script_verify__invalid_signature__speculates_and_fails_verify)
+{
+    ec_compressed point;
+    BOOST_REQUIRE(secret_to_public(point, secret));
+    const script prevout_script(script::to_pay_key_hash_pattern(bitcoin_short_hash(point)));
+    const auto tx = spending_tx();
+    const auto other = hash_literal("0000000000000000000000000000000000000000000000000000000000000042");
+    const auto input_script = endorse(tx, prevout_script, other, point);
+
+    signature_queue deferred;
+    BOOST_REQUIRE_EQUAL(script::verify(tx, 0, rule_fork::all_rules, input_script, {}, prevout_script, 100000, &deferred), error::success);
+    BOOST_REQUIRE_EQUAL(deferred.size(), 1u);
+    BOOST_REQUIRE(!deferred.verify());
+    BOOST_REQUIRE(script::verify(tx, 0, rule_fork::all_rules, input_script, {}, prevout_script, 100000) != error::success);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
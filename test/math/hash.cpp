@@ -58,6 +58,46 @@ BOOST_AUTO_TEST_CASE(sha256_hash_test)
     BOOST_REQUIRE_EQUAL(encode_base16(hash), "3a6eb0790f39ac87c94f3856b2dd2c5d110e6811602261a9a923d3bb23adc8b7");
 }
 
+BOOST_AUTO_TEST_CASE(sha256_hash_multiple_block_test)
+{
+    const std::string text = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    const auto hash1 = sha256_hash(to_chunk(text));
+    BOOST_REQUIRE_EQUAL(encode_base16(hash1), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    const data_chunk million(1000000, 'a');
+    const auto hash2 = sha256_hash(million);
+    BOOST_REQUIRE_EQUAL(encode_base16(hash2), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_pairs_test)
+{
+    hash_list hashes;
+    for (uint8_t index = 0; index < 38; ++index)
+        hashes.push_back(sha256_hash(to_chunk(index)));
+
+    hash_list expected;
+    for (size_t index = 0; index < hashes.size(); index += 2)
+        expected.push_back(bitcoin_hash(build_chunk({ hashes[index], hashes[index + 1] })));
+
+    hash_list out;
+    bitcoin_hash_pairs(out, hashes);
+    BOOST_REQUIRE(out == expected);
+
+    bitcoin_hash_pairs(hashes, hashes);
+    BOOST_REQUIRE(hashes == expected);
+
+    bitcoin_hash_pairs(out, hash_list{});
+    BOOST_REQUIRE(out.empty());
+}
+
+BOOST_AUTO_TEST_CASE(bitcoin_hash_two_hashes_test)
+{
+    const auto left = sha256_hash(to_chunk(uint8_t(42)));
+    const auto right = sha256_hash(to_chunk(uint8_t(24)));
+    const auto expected = bitcoin_hash(build_chunk({ left, right }));
+    BOOST_REQUIRE(bitcoin_hash(left, right) == expected);
+}
+
 BOOST_AUTO_TEST_CASE(sha512_hash_test)
 {
     const data_chunk chunk{ 'd', 'a', 't', 'a' };
@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(compute_once_tests)
+
+BOOST_AUTO_TEST_CASE(compute_once__constructor__default__not_set)
+{
+    const compute_once<size_t> instance;
+    BOOST_REQUIRE(!instance.is_set());
+}
+
+BOOST_AUTO_TEST_CASE(compute_once__constructor__value__set)
+{
+    const compute_once<size_t> instance(42);
+    BOOST_REQUIRE(instance.is_set());
+    BOOST_REQUIRE_EQUAL(instance.get([]() { return size_t(0); }), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(compute_once__get__empty__computes_once)
+{
+    size_t calls = 0;
+    const auto compute = [&calls]()
+    {
+        ++calls;
+        return size_t(42);
+    };
+
+    const compute_once<size_t> instance;
+    BOOST_REQUIRE_EQUAL(instance.get(compute), 42u);
+    BOOST_REQUIRE_EQUAL(instance.get(compute), 42u);
+    BOOST_REQUIRE(instance.is_set());
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(compute_once__get__throws__remains_empty)
+{
+    const compute_once<size_t> instance;
+    const auto fail = []() -> size_t
+    {
+        throw std::runtime_error("fail");
+    };
+
+    BOOST_REQUIRE_THROW(instance.get(fail), std::runtime_error);
+    BOOST_REQUIRE(!instance.is_set());
+    BOOST_REQUIRE_EQUAL(instance.get([]() { return size_t(42); }), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(compute_once__set__empty__publishes_value)
+{
+    compute_once<size_t> instance;
+    instance.set(42);
+    BOOST_REQUIRE(instance.is_set());
+    BOOST_REQUIRE_EQUAL(instance.get([]() { return size_t(0); }), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(compute_once__reset__set__recomputes)
+{
+    compute_once<size_t> instance(42);
+    instance.reset();
+    BOOST_REQUIRE(!instance.is_set());
+    BOOST_REQUIRE_EQUAL(instance.get([]() { return size_t(24); }), 24u);
+}
+
+BOOST_AUTO_TEST_CASE(compute_once__copy__set__copies_value)
+{
+    const compute_once<data_chunk> other(data_chunk{ 1, 2, 3 });
+    const compute_once<data_chunk> instance(other);
+    BOOST_REQUIRE(other.is_set());
+    BOOST_REQUIRE(instance.is_set());
+    BOOST_REQUIRE(instance.get([]() { return data_chunk{}; }) ==
+        (data_chunk{ 1, 2, 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(compute_once__copy_assign__empty__resets)
+{
+    const compute_once<size_t> other;
+    compute_once<size_t> instance(42);
+    instance = other;
+    BOOST_REQUIRE(!instance.is_set());
+}
+
+BOOST_AUTO_TEST_CASE(compute_once__move__set__moves_value_and_resets_other)
+{
+    compute_once<data_chunk> other(data_chunk{ 1, 2, 3 });
+    const compute_once<data_chunk> instance(std::move(other));
+    BOOST_REQUIRE(!other.is_set());
+    BOOST_REQUIRE(instance.is_set());
+    BOOST_REQUIRE(instance.get([]() { return data_chunk{}; }) ==
+        (data_chunk{ 1, 2, 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(compute_once__get__concurrent__computes_once)
+{
+    static const size_t threads = 8;
+    std::atomic<size_t> calls(0);
+    const auto compute = [&calls]()
+    {
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return size_t(42);
+    };
+
+    const compute_once<size_t> instance;
+    std::vector<size_t> results(threads, 0);
+    std::vector<std::thread> workers;
+
+    for (size_t index = 0; index < threads; ++index)
+        workers.emplace_back([&, index]()
+        {
+            results[index] = instance.get(compute);
+        });
+
+    for (auto& worker: workers)
+        worker.join();
+
+    BOOST_REQUIRE_EQUAL(calls.load(), 1u);
+
+    for (const auto result: results)
+        BOOST_REQUIRE_EQUAL(result, 42u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(flat_hash_set_tests)
+
+// A degenerate hasher, so that every key probes the same slot sequence.
+struct colliding_hasher
+{
+    uint64_t operator()(size_t) const
+    {
+        return 42;
+    }
+};
+
+static hash_digest test_hash(size_t value)
+{
+    auto hash = null_hash;
+    hash[0] = static_cast<uint8_t>(value);
+    hash[1] = static_cast<uint8_t>(value >> 8);
+    return hash;
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__constructor__default__empty)
+{
+    const hash_set instance;
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(!instance.contains(null_hash));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__insert__distinct__contains_all)
+{
+    hash_set instance(10);
+
+    for (size_t index = 0; index < 1000; ++index)
+        BOOST_REQUIRE(instance.insert(test_hash(index)));
+
+    BOOST_REQUIRE_EQUAL(instance.size(), 1000u);
+
+    for (size_t index = 0; index < 1000; ++index)
+        BOOST_REQUIRE(instance.contains(test_hash(index)));
+
+    BOOST_REQUIRE(!instance.contains(test_hash(1000)));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__insert__duplicate__false)
+{
+    hash_set instance(2);
+    BOOST_REQUIRE(instance.insert(null_hash));
+    BOOST_REQUIRE(!instance.insert(null_hash));
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__insert__colliding__distinguishes_keys)
+{
+    flat_hash_set<size_t, colliding_hasher> instance(4);
+
+    for (size_t index = 0; index < 100; ++index)
+        BOOST_REQUIRE(instance.insert(index));
+
+    for (size_t index = 0; index < 100; ++index)
+        BOOST_REQUIRE(!instance.insert(index));
+
+    BOOST_REQUIRE_EQUAL(instance.size(), 100u);
+    BOOST_REQUIRE(!instance.contains(100));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__clear__populated__empty)
+{
+    hash_set instance(4);
+    instance.insert(test_hash(1));
+    instance.insert(test_hash(2));
+    instance.clear();
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE(!instance.contains(test_hash(1)));
+    BOOST_REQUIRE(instance.insert(test_hash(1)));
+}
+
+BOOST_AUTO_TEST_CASE(flat_hash_set__insert__points_same_hash__distinguishes_index)
+{
+    chain::point::set instance(4);
+    BOOST_REQUIRE(instance.insert({ null_hash, 0 }));
+    BOOST_REQUIRE(instance.insert({ null_hash, 1 }));
+    BOOST_REQUIRE(!instance.insert({ null_hash, 1 }));
+    BOOST_REQUIRE(instance.contains({ null_hash, 0 }));
+    BOOST_REQUIRE(!instance.contains({ null_hash, 2 }));
+}
+
+BOOST_AUTO_TEST_CASE(salted_hasher__instances__differently_salted)
+{
+    const salted_hasher first;
+    const salted_hasher second;
+    const auto hash = test_hash(42);
+    BOOST_REQUIRE_EQUAL(first(hash), first(hash));
+    BOOST_REQUIRE(first(hash) != second(hash));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(parallel_tests)
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__zero_count__returns_zero)
+{
+    threadpool pool(2);
+    const auto result = parallel_for(pool, 0, 4, [](size_t)
+    {
+        return false;
+    });
+
+    BOOST_REQUIRE_EQUAL(result, 0u);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__all_succeed__returns_count_and_visits_all)
+{
+    static const size_t count = 1000;
+    threadpool pool(4);
+    std::vector<std::atomic<size_t>> visits(count);
+
+    for (auto& visit: visits)
+        visit = 0;
+
+    const auto result = parallel_for(pool, count, 7, [&visits](size_t index)
+    {
+        ++visits[index];
+        return true;
+    });
+
+    BOOST_REQUIRE_EQUAL(result, count);
+
+    for (const auto& visit: visits)
+        BOOST_REQUIRE_EQUAL(visit.load(), 1u);
+
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__multiple_failures__returns_lowest)
+{
+    threadpool pool(4);
+    const auto result = parallel_for(pool, 1000, 3, [](size_t index)
+    {
+        return index != 997 && index != 421 && index != 422;
+    });
+
+    BOOST_REQUIRE_EQUAL(result, 421u);
+    pool.shutdown();
+    pool.join();
+}
+
+BOOST_AUTO_TEST_CASE(parallel__parallel_for__empty_pool__executes_on_caller)
+{
+    threadpool pool;
+    size_t visits = 0;
+    const auto result = parallel_for(pool, 100, 10, [&visits](size_t index)
+    {
+        ++visits;
+        return index != 42;
+    });
+
+    BOOST_REQUIRE_EQUAL(result, 42u);
+    BOOST_REQUIRE_EQUAL(visits, 43u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(sha256_writer_tests)
+
+BOOST_AUTO_TEST_CASE(sha256_writer__sha256_hash__empty__expected)
+{
+    sha256_writer sink;
+    BOOST_REQUIRE(sink);
+    BOOST_REQUIRE_EQUAL(encode_base16(sink.sha256_hash()), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    BOOST_REQUIRE(!sink);
+}
+
+BOOST_AUTO_TEST_CASE(sha256_writer__bitcoin_hash__written_values__matches_serialized_hash)
+{
+    data_chunk expected;
+    data_sink ostream(expected);
+    ostream_writer source(ostream);
+    sha256_writer sink;
+
+    const auto write = [](writer& out)
+    {
+        out.write_4_bytes_little_endian(0x01020304);
+        out.write_8_bytes_big_endian(0x0102030405060708);
+        out.write_variable_little_endian(0x1234);
+        out.write_variable_little_endian(0x12345678);
+        out.write_variable_little_endian(0x123456789a);
+        out.write_hash(null_hash);
+        out.write_string("libbitcoin");
+        out.write_string("abc", 8);
+        out.write_byte(42);
+    };
+
+    write(source);
+    ostream.flush();
+    write(sink);
+    BOOST_REQUIRE_EQUAL(encode_base16(sink.bitcoin_hash()), encode_base16(bitcoin_hash(expected)));
+}
+
+BOOST_AUTO_TEST_CASE(sha256_writer__bitcoin_hash__genesis_transaction__transaction_hash)
+{
+    const auto genesis = chain::block::genesis_mainnet();
+    const auto& tx = genesis.transactions().front();
+    sha256_writer sink;
+    tx.to_data(sink);
+    BOOST_REQUIRE(sink.bitcoin_hash() == tx.hash());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2011-2017 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <bitcoin/bitcoin.hpp>
+
+using namespace bc;
+
+BOOST_AUTO_TEST_SUITE(sliding_window_tests)
+
+typedef sliding_window<uint32_t> window;
+
+BOOST_AUTO_TEST_CASE(sliding_window__constructor__default__empty)
+{
+    const window instance;
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(instance.begin() == instance.end());
+}
+
+BOOST_AUTO_TEST_CASE(sliding_window__constructor__initializer_list__ordered)
+{
+    const window instance{ 1, 2, 3 };
+    BOOST_REQUIRE_EQUAL(instance.size(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.front(), 1u);
+    BOOST_REQUIRE_EQUAL(instance[1], 2u);
+    BOOST_REQUIRE_EQUAL(instance.back(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(sliding_window__pop_front__all__empty)
+{
+    window instance{ 1, 2 };
+    instance.pop_front();
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.front(), 2u);
+    instance.pop_front();
+    BOOST_REQUIRE(instance.empty());
+}
+
+BOOST_AUTO_TEST_CASE(sliding_window__push_back__advanced__matches_deque)
+{
+    window instance;
+    std::deque<uint32_t> expected;
+
+    for (uint32_t value = 0; value < 10000; ++value)
+    {
+        instance.push_back(value);
+        expected.push_back(value);
+
+        if (expected.size() > 2016)
+        {
+            instance.pop_front();
+            expected.pop_front();
+        }
+
+        BOOST_REQUIRE_EQUAL(instance.size(), expected.size());
+        BOOST_REQUIRE_EQUAL(instance.front(), expected.front());
+        BOOST_REQUIRE_EQUAL(instance.back(), expected.back());
+    }
+
+    BOOST_REQUIRE(std::equal(instance.begin(), instance.end(), expected.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(sliding_window__copy__advanced__copies_window)
+{
+    window instance{ 1, 2, 3, 4 };
+    instance.pop_front();
+    const window copy(instance);
+    BOOST_REQUIRE(copy == instance);
+    BOOST_REQUIRE_EQUAL(copy.size(), 3u);
+    BOOST_REQUIRE_EQUAL(copy.front(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(sliding_window__move__advanced__moves_window)
+{
+    window instance{ 1, 2, 3, 4 };
+    instance.pop_front();
+    const window moved(std::move(instance));
+    BOOST_REQUIRE(instance.empty());
+    BOOST_REQUIRE_EQUAL(moved.size(), 3u);
+    BOOST_REQUIRE_EQUAL(moved.front(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(sliding_window__resize__advanced__preserves_window)
+{
+    window instance{ 1, 2, 3 };
+    instance.pop_front();
+    instance.resize(4);
+    BOOST_REQUIRE_EQUAL(instance.size(), 4u);
+    BOOST_REQUIRE_EQUAL(instance[0], 2u);
+    BOOST_REQUIRE_EQUAL(instance[1], 3u);
+    BOOST_REQUIRE_EQUAL(instance[3], 0u);
+}
+
+BOOST_AUTO_TEST_CASE(sliding_window__operator_equals__different_starts__true)
+{
+    window instance{ 0, 1, 2 };
+    instance.pop_front();
+    const window other{ 1, 2 };
+    BOOST_REQUIRE(instance == other);
+    BOOST_REQUIRE(!(instance != other));
+}
+
+BOOST_AUTO_TEST_SUITE_END()